@@ -1,7 +1,10 @@
 #ifndef STRUCTURES_LINKED_LIST_H
 #define STRUCTURES_LINKED_LIST_H
 
+#include <cstddef>
 #include <cstdint>
+#include <iterator>
+#include <type_traits>
 
 
 namespace structures {
@@ -73,6 +76,64 @@ class CircularList {
 
     Node* head{nullptr};
     std::size_t size_{0u};
+
+    // The last node links back to head, so the iterator counts positions
+    // and end() is the position size_ rather than a null node.
+    template<typename NodePointer, typename Reference>
+    class Iterator {
+     public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef T value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef typename std::remove_reference<Reference>::type* pointer;
+        typedef Reference reference;
+
+        Iterator(NodePointer node, std::size_t index):
+            node_{node},
+            index_{index}
+        {}
+
+        Reference operator*() const {
+            return node_->data();
+        }
+
+        pointer operator->() const {
+            return &node_->data();
+        }
+
+        Iterator& operator++() {
+            node_ = node_->next();
+            index_++;
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        bool operator==(const Iterator& other) const {
+            return index_ == other.index_;
+        }
+
+        bool operator!=(const Iterator& other) const {
+            return index_ != other.index_;
+        }
+
+     private:
+        NodePointer node_;
+        std::size_t index_;
+    };
+
+ public:
+    typedef Iterator<Node*, T&> iterator;
+    typedef Iterator<const Node*, const T&> const_iterator;
+
+    iterator begin();
+    iterator end();
+    const_iterator begin() const;
+    const_iterator end() const;
 };
 
 }  // namespace structures
@@ -224,4 +285,24 @@ std::size_t structures::CircularList<T>::find(const T& data) const {
 template<typename T>
 std::size_t structures::CircularList<T>::size() const {
     return size_;
-}
\ No newline at end of file
+}
+
+template<typename T>
+typename structures::CircularList<T>::iterator structures::CircularList<T>::begin() {
+    return iterator(head, 0);
+}
+
+template<typename T>
+typename structures::CircularList<T>::iterator structures::CircularList<T>::end() {
+    return iterator(nullptr, size_);
+}
+
+template<typename T>
+typename structures::CircularList<T>::const_iterator structures::CircularList<T>::begin() const {
+    return const_iterator(head, 0);
+}
+
+template<typename T>
+typename structures::CircularList<T>::const_iterator structures::CircularList<T>::end() const {
+    return const_iterator(nullptr, size_);
+}
@@ -1,3 +1,7 @@
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
 namespace structures {
 
 template<typename T>
@@ -93,6 +97,76 @@ class DoublyCircularList {
     Node* head{nullptr};
     Node* tail{nullptr};
     std::size_t size_{0u};
+
+    // The list closes on itself, so end() sits on head again and stepping
+    // back from it reaches tail. Positions are told apart by index.
+    template<typename NodePointer, typename Reference>
+    class Iterator {
+     public:
+        typedef std::bidirectional_iterator_tag iterator_category;
+        typedef T value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef typename std::remove_reference<Reference>::type* pointer;
+        typedef Reference reference;
+
+        Iterator(NodePointer node, std::size_t index):
+            node_{node},
+            index_{index}
+        {}
+
+        Reference operator*() const {
+            return node_->data();
+        }
+
+        pointer operator->() const {
+            return &node_->data();
+        }
+
+        Iterator& operator++() {
+            node_ = node_->next();
+            index_++;
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        Iterator& operator--() {
+            node_ = node_->prev();
+            index_--;
+            return *this;
+        }
+
+        Iterator operator--(int) {
+            Iterator next = *this;
+            --*this;
+            return next;
+        }
+
+        bool operator==(const Iterator& other) const {
+            return index_ == other.index_;
+        }
+
+        bool operator!=(const Iterator& other) const {
+            return index_ != other.index_;
+        }
+
+     private:
+        NodePointer node_;
+        std::size_t index_;
+    };
+
+ public:
+    typedef Iterator<Node*, T&> iterator;
+    typedef Iterator<const Node*, const T&> const_iterator;
+
+    iterator begin();
+    iterator end();
+    const_iterator begin() const;
+    const_iterator end() const;
 };
 
 }  // namespace structures
@@ -123,6 +197,8 @@ void structures::DoublyCircularList<T>::push_back(const T& data) {
     Node* new_node = new Node(data);
     if (size_ == 0) {
         head = new_node;
+        new_node->prev(new_node);
+        new_node->next(new_node);
     } else {
         tail->next(new_node);
         new_node->prev(tail);
@@ -135,10 +211,13 @@ void structures::DoublyCircularList<T>::push_back(const T& data) {
 
 template<typename T>
 void structures::DoublyCircularList<T>::push_front(const T& data) {
-    Node* new_node = new Node(data, head);
-    if (size_ > 0) {
-        head->prev(new_node);
+    if (size_ == 0) {
+        push_back(data);
+        return;
     }
+    Node* new_node = new Node(data, tail, head);
+    tail->next(new_node);
+    head->prev(new_node);
     head = new_node;
     size_++;
 }
@@ -150,10 +229,13 @@ void structures::DoublyCircularList<T>::insert(
         throw std::out_of_range("invalid index");
     } else if (index == 0) {
         push_front(data);
+    } else if (index == size_) {
+        push_back(data);
     } else {
         Node* current = node_at(index);
         Node* new_node = new Node(data, current->prev(), current);
         current->prev()->next(new_node);
+        current->prev(new_node);
         size_++;
     }
 }
@@ -185,10 +267,11 @@ T structures::DoublyCircularList<T>::pop(std::size_t index) {
     Node* popped = node_at(index);
     Node* previous = popped->prev();
     Node* following = popped->next();
-    if (following != nullptr) {
-        following->prev(previous);
-    }
+    following->prev(previous);
     previous->next(following);
+    if (popped == tail) {
+        tail = previous;
+    }
 
     T data = popped->data();
     delete popped;
@@ -210,7 +293,14 @@ T structures::DoublyCircularList<T>::pop_front() {
     Node* new_head = head->next();
     delete head;
     size_--;
-    head = new_head;
+    if (size_ == 0) {
+        head = nullptr;
+        tail = nullptr;
+    } else {
+        head = new_head;
+        head->prev(tail);
+        tail->next(head);
+    }
     return data;
 }
 
@@ -262,3 +352,23 @@ template<typename T>
 std::size_t structures::DoublyCircularList<T>::size() const {
     return size_;
 }
+
+template<typename T>
+typename structures::DoublyCircularList<T>::iterator structures::DoublyCircularList<T>::begin() {
+    return iterator(head, 0);
+}
+
+template<typename T>
+typename structures::DoublyCircularList<T>::iterator structures::DoublyCircularList<T>::end() {
+    return iterator(head, size_);
+}
+
+template<typename T>
+typename structures::DoublyCircularList<T>::const_iterator structures::DoublyCircularList<T>::begin() const {
+    return const_iterator(head, 0);
+}
+
+template<typename T>
+typename structures::DoublyCircularList<T>::const_iterator structures::DoublyCircularList<T>::end() const {
+    return const_iterator(head, size_);
+}
@@ -1,3 +1,7 @@
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
 namespace structures {
 
 template<typename T>
@@ -93,6 +97,77 @@ class DoublyLinkedList {
     Node* head{nullptr};
     Node* tail{nullptr};
     std::size_t size_{0u};
+
+    // end() has no node, so stepping back from it starts at tail.
+    template<typename NodePointer, typename Reference>
+    class Iterator {
+     public:
+        typedef std::bidirectional_iterator_tag iterator_category;
+        typedef T value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef typename std::remove_reference<Reference>::type* pointer;
+        typedef Reference reference;
+
+        Iterator(NodePointer node, NodePointer tail, std::size_t index):
+            node_{node},
+            tail_{tail},
+            index_{index}
+        {}
+
+        Reference operator*() const {
+            return node_->data();
+        }
+
+        pointer operator->() const {
+            return &node_->data();
+        }
+
+        Iterator& operator++() {
+            node_ = node_->next();
+            index_++;
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        Iterator& operator--() {
+            node_ = node_ == nullptr ? tail_ : node_->prev();
+            index_--;
+            return *this;
+        }
+
+        Iterator operator--(int) {
+            Iterator next = *this;
+            --*this;
+            return next;
+        }
+
+        bool operator==(const Iterator& other) const {
+            return index_ == other.index_;
+        }
+
+        bool operator!=(const Iterator& other) const {
+            return index_ != other.index_;
+        }
+
+     private:
+        NodePointer node_;
+        NodePointer tail_;
+        std::size_t index_;
+    };
+
+ public:
+    typedef Iterator<Node*, T&> iterator;
+    typedef Iterator<const Node*, const T&> const_iterator;
+
+    iterator begin();
+    iterator end();
+    const_iterator begin() const;
+    const_iterator end() const;
 };
 
 }  // namespace structures
@@ -134,7 +209,9 @@ void structures::DoublyLinkedList<T>::push_back(const T& data) {
 template<typename T>
 void structures::DoublyLinkedList<T>::push_front(const T& data) {
     Node* new_node = new Node(data, head);
-    if (size_ > 0) {
+    if (size_ == 0) {
+        tail = new_node;
+    } else {
         head->prev(new_node);
     }
     head = new_node;
@@ -147,10 +224,13 @@ void structures::DoublyLinkedList<T>::insert(const T& data, std::size_t index) {
         throw std::out_of_range("invalid index");
     } else if (index == 0) {
         push_front(data);
+    } else if (index == size_) {
+        push_back(data);
     } else {
         Node* current = node_at(index);
         Node* new_node = new Node(data, current->prev(), current);
         current->prev()->next(new_node);
+        current->prev(new_node);
         size_++;
     }
 }
@@ -184,6 +264,8 @@ T structures::DoublyLinkedList<T>::pop(std::size_t index) {
     Node* following = popped->next();
     if (following != nullptr) {
         following->prev(previous);
+    } else {
+        tail = previous;
     }
     previous->next(following);
 
@@ -208,6 +290,11 @@ T structures::DoublyLinkedList<T>::pop_front() {
     delete head;
     size_--;
     head = new_head;
+    if (size_ == 0) {
+        tail = nullptr;
+    } else {
+        head->prev(nullptr);
+    }
     return data;
 }
 
@@ -259,3 +346,23 @@ template<typename T>
 std::size_t structures::DoublyLinkedList<T>::size() const {
     return size_;
 }
+
+template<typename T>
+typename structures::DoublyLinkedList<T>::iterator structures::DoublyLinkedList<T>::begin() {
+    return iterator(head, tail, 0);
+}
+
+template<typename T>
+typename structures::DoublyLinkedList<T>::iterator structures::DoublyLinkedList<T>::end() {
+    return iterator(nullptr, tail, size_);
+}
+
+template<typename T>
+typename structures::DoublyLinkedList<T>::const_iterator structures::DoublyLinkedList<T>::begin() const {
+    return const_iterator(head, tail, 0);
+}
+
+template<typename T>
+typename structures::DoublyLinkedList<T>::const_iterator structures::DoublyLinkedList<T>::end() const {
+    return const_iterator(nullptr, tail, size_);
+}
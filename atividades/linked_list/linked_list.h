@@ -1,7 +1,10 @@
 #ifndef STRUCTURES_LINKED_LIST_H
 #define STRUCTURES_LINKED_LIST_H
 
+#include <cstddef>
 #include <cstdint>
+#include <iterator>
+#include <type_traits>
 
 
 namespace structures {
@@ -73,6 +76,63 @@ class LinkedList {
 
     Node* head{nullptr};
     std::size_t size_{0u};
+
+    // Forward iterator; end() is the position just past the last node.
+    template<typename NodePointer, typename Reference>
+    class Iterator {
+     public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef T value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef typename std::remove_reference<Reference>::type* pointer;
+        typedef Reference reference;
+
+        Iterator(NodePointer node, std::size_t index):
+            node_{node},
+            index_{index}
+        {}
+
+        Reference operator*() const {
+            return node_->data();
+        }
+
+        pointer operator->() const {
+            return &node_->data();
+        }
+
+        Iterator& operator++() {
+            node_ = node_->next();
+            index_++;
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        bool operator==(const Iterator& other) const {
+            return index_ == other.index_;
+        }
+
+        bool operator!=(const Iterator& other) const {
+            return index_ != other.index_;
+        }
+
+     private:
+        NodePointer node_;
+        std::size_t index_;
+    };
+
+ public:
+    typedef Iterator<Node*, T&> iterator;
+    typedef Iterator<const Node*, const T&> const_iterator;
+
+    iterator begin();
+    iterator end();
+    const_iterator begin() const;
+    const_iterator end() const;
 };
 
 }
@@ -216,3 +276,23 @@ template<typename T>
 std::size_t structures::LinkedList<T>::size() const {
     return size_;
 }
+
+template<typename T>
+typename structures::LinkedList<T>::iterator structures::LinkedList<T>::begin() {
+    return iterator(head, 0);
+}
+
+template<typename T>
+typename structures::LinkedList<T>::iterator structures::LinkedList<T>::end() {
+    return iterator(nullptr, size_);
+}
+
+template<typename T>
+typename structures::LinkedList<T>::const_iterator structures::LinkedList<T>::begin() const {
+    return const_iterator(head, 0);
+}
+
+template<typename T>
+typename structures::LinkedList<T>::const_iterator structures::LinkedList<T>::end() const {
+    return const_iterator(nullptr, size_);
+}
@@ -1,3 +1,7 @@
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
 namespace structures {
 
 
@@ -54,6 +58,63 @@ class LinkedQueue {
     Node* head{nullptr};
     Node* tail{nullptr};
     std::size_t size_{0u};
+
+    // Walks the queue from front to back.
+    template<typename NodePointer, typename Reference>
+    class Iterator {
+     public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef T value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef typename std::remove_reference<Reference>::type* pointer;
+        typedef Reference reference;
+
+        Iterator(NodePointer node, std::size_t index):
+            node_{node},
+            index_{index}
+        {}
+
+        Reference operator*() const {
+            return node_->data();
+        }
+
+        pointer operator->() const {
+            return &node_->data();
+        }
+
+        Iterator& operator++() {
+            node_ = node_->next();
+            index_++;
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        bool operator==(const Iterator& other) const {
+            return index_ == other.index_;
+        }
+
+        bool operator!=(const Iterator& other) const {
+            return index_ != other.index_;
+        }
+
+     private:
+        NodePointer node_;
+        std::size_t index_;
+    };
+
+ public:
+    typedef Iterator<Node*, T&> iterator;
+    typedef Iterator<const Node*, const T&> const_iterator;
+
+    iterator begin();
+    iterator end();
+    const_iterator begin() const;
+    const_iterator end() const;
 };
 
 }  // namespace structures
@@ -130,3 +191,23 @@ template<typename T>
 std::size_t structures::LinkedQueue<T>::size() const {
     return size_;
 }
+
+template<typename T>
+typename structures::LinkedQueue<T>::iterator structures::LinkedQueue<T>::begin() {
+    return iterator(head, 0);
+}
+
+template<typename T>
+typename structures::LinkedQueue<T>::iterator structures::LinkedQueue<T>::end() {
+    return iterator(nullptr, size_);
+}
+
+template<typename T>
+typename structures::LinkedQueue<T>::const_iterator structures::LinkedQueue<T>::begin() const {
+    return const_iterator(head, 0);
+}
+
+template<typename T>
+typename structures::LinkedQueue<T>::const_iterator structures::LinkedQueue<T>::end() const {
+    return const_iterator(nullptr, size_);
+}
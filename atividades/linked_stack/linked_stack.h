@@ -1,3 +1,7 @@
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
 namespace structures {
 
 template<typename T>
@@ -49,7 +53,64 @@ class LinkedStack {
     };
 
     Node* top_{nullptr};
-    std::size_t size_{0u}
+    std::size_t size_{0u};
+
+    // Walks the stack from top to bottom.
+    template<typename NodePointer, typename Reference>
+    class Iterator {
+     public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef T value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef typename std::remove_reference<Reference>::type* pointer;
+        typedef Reference reference;
+
+        Iterator(NodePointer node, std::size_t index):
+            node_{node},
+            index_{index}
+        {}
+
+        Reference operator*() const {
+            return node_->data();
+        }
+
+        pointer operator->() const {
+            return &node_->data();
+        }
+
+        Iterator& operator++() {
+            node_ = node_->next();
+            index_++;
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        bool operator==(const Iterator& other) const {
+            return index_ == other.index_;
+        }
+
+        bool operator!=(const Iterator& other) const {
+            return index_ != other.index_;
+        }
+
+     private:
+        NodePointer node_;
+        std::size_t index_;
+    };
+
+ public:
+    typedef Iterator<Node*, T&> iterator;
+    typedef Iterator<const Node*, const T&> const_iterator;
+
+    iterator begin();
+    iterator end();
+    const_iterator begin() const;
+    const_iterator end() const;
 };
 
 }  // namespace structures
@@ -111,3 +172,23 @@ template<typename T>
 std::size_t structures::LinkedStack<T>::size() const {
     return size_;
 }
+
+template<typename T>
+typename structures::LinkedStack<T>::iterator structures::LinkedStack<T>::begin() {
+    return iterator(top_, 0);
+}
+
+template<typename T>
+typename structures::LinkedStack<T>::iterator structures::LinkedStack<T>::end() {
+    return iterator(nullptr, size_);
+}
+
+template<typename T>
+typename structures::LinkedStack<T>::const_iterator structures::LinkedStack<T>::begin() const {
+    return const_iterator(top_, 0);
+}
+
+template<typename T>
+typename structures::LinkedStack<T>::const_iterator structures::LinkedStack<T>::end() const {
+    return const_iterator(nullptr, size_);
+}
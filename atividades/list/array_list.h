@@ -2,15 +2,27 @@
 #define STRUCTURES_ARRAY_LIST_H
 
 #include <cstdint>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
 
+#include "array_search.h"
 
 namespace structures {
 
 template<typename T>
 class ArrayList {
  public:
+    // Elements are contiguous, so plain pointers are random access
+    // iterators.
+    typedef T* iterator;
+    typedef const T* const_iterator;
+
     ArrayList();
     explicit ArrayList(std::size_t max_size);
+    ArrayList(std::size_t max_size, bool auto_grow);
     ~ArrayList();
 
     void clear();
@@ -18,6 +30,12 @@ class ArrayList {
     void push_front(const T& data);
     void insert(const T& data, std::size_t index);
     void insert_sorted(const T& data);
+    template<typename... Args>
+    void emplace_back(Args&&... args);
+    template<typename... Args>
+    void emplace(std::size_t index, Args&&... args);
+    void insert_range(std::size_t index, const T* data, std::size_t count);
+    void erase_range(std::size_t first, std::size_t last);
     T pop(std::size_t index);
     T pop_back();
     T pop_front();
@@ -26,46 +44,81 @@ class ArrayList {
     bool empty() const;
     bool contains(const T& data) const;
     std::size_t find(const T& data) const;
+    std::size_t count(const T& data) const;
+    std::size_t lower_bound(const T& data) const;
+    std::size_t upper_bound(const T& data) const;
     std::size_t size() const;
     std::size_t max_size() const;
+    void reserve(std::size_t max_size);
+    void shrink_to_fit();
     T& at(std::size_t index);
     T& operator[](std::size_t index);
     const T& at(std::size_t index) const;
     const T& operator[](std::size_t index) const;
+    iterator begin();
+    iterator end();
+    const_iterator begin() const;
+    const_iterator end() const;
 
  private:
+    static T* allocate(std::size_t max_size);
+    void make_room(std::size_t count = 1);
+    void relocate(std::size_t max_size);
+    void open_gap(std::size_t index, std::size_t count);
+    void close_gap(std::size_t index, std::size_t count);
+
+    // Only the first size_ slots hold constructed elements; the rest is
+    // raw storage.
     T* contents;
     std::size_t size_;
     std::size_t max_size_;
+    bool auto_grow_{false};
 
     static const auto DEFAULT_MAX = 10u;
 };
 
 }  // namespace structures
 
-#endif
-
 template<typename T>
 structures::ArrayList<T>::ArrayList() {
     size_ = 0;
     max_size_ = DEFAULT_MAX;
-    contents = new T[max_size_];
+    contents = allocate(max_size_);
 }
 
 template<typename T>
 structures::ArrayList<T>::ArrayList(std::size_t max_size) {
     size_ = 0;
     max_size_ = max_size;
-    contents = new T[max_size_];
+    contents = allocate(max_size_);
+}
+
+// With auto_grow the capacity doubles whenever an insertion finds the
+// list full, instead of throwing "no space".
+template<typename T>
+structures::ArrayList<T>::ArrayList(std::size_t max_size, bool auto_grow) {
+    size_ = 0;
+    max_size_ = max_size;
+    contents = allocate(max_size_);
+    auto_grow_ = auto_grow;
 }
 
 template<typename T>
 structures::ArrayList<T>::~ArrayList() {
-    delete [] contents;
+    clear();
+    ::operator delete(contents);
+}
+
+template<typename T>
+T* structures::ArrayList<T>::allocate(std::size_t max_size) {
+    return static_cast<T*>(::operator new(max_size * sizeof(T)));
 }
 
 template<typename T>
 void structures::ArrayList<T>::clear() {
+    for (std::size_t i = 0; i < size_; i++) {
+        contents[i].~T();
+    }
     size_ = 0;
 }
 
@@ -81,24 +134,46 @@ bool structures::ArrayList<T>::empty() const {
 
 template<typename T>
 bool structures::ArrayList<T>::contains(const T& data) const {
-    for (std::size_t i = 0; i < size_; i++) {
-        if (data == contents[i]) {
-            return true;
-        }
-    }
-    return false;
+    return find(data) != size_;
 }
 
+// Arithmetic elements are compared a vector at a time, see array_search.h.
 template<typename T>
 std::size_t structures::ArrayList<T>::find(const T& data) const {
-    std::size_t i = 0;
-    while (i < size_) {
-        if (contents[i] == data) {
-            break;
-        }
-        i++;
+    return search::find(contents, size_, data);
+}
+
+template<typename T>
+std::size_t structures::ArrayList<T>::count(const T& data) const {
+    return search::count(contents, size_, data);
+}
+
+// First index whose element is not smaller than data, for a sorted list.
+// The search halves the range without branching on the comparison, so it
+// compiles to conditional moves instead of mispredicted jumps.
+template<typename T>
+std::size_t structures::ArrayList<T>::lower_bound(const T& data) const {
+    std::size_t first = 0;
+    std::size_t length = size_;
+    while (length > 1) {
+        std::size_t half = length / 2;
+        first += (data > contents[first + half - 1]) ? half : 0;
+        length -= half;
     }
-    return i;
+    return first + (length == 1 && data > contents[first]);
+}
+
+// First index whose element is greater than data, for a sorted list.
+template<typename T>
+std::size_t structures::ArrayList<T>::upper_bound(const T& data) const {
+    std::size_t first = 0;
+    std::size_t length = size_;
+    while (length > 1) {
+        std::size_t half = length / 2;
+        first += (contents[first + half - 1] > data) ? 0 : half;
+        length -= half;
+    }
+    return first + (length == 1 && !(contents[first] > data));
 }
 
 template<typename T>
@@ -112,56 +187,175 @@ std::size_t structures::ArrayList<T>::max_size() const {
 }
 
 template<typename T>
-void structures::ArrayList<T>::push_back(const T& data) {
-    if (full()) {
+void structures::ArrayList<T>::reserve(std::size_t max_size) {
+    if (max_size > max_size_) {
+        relocate(max_size);
+    }
+}
+
+template<typename T>
+void structures::ArrayList<T>::shrink_to_fit() {
+    if (size_ < max_size_) {
+        relocate(size_);
+    }
+}
+
+template<typename T>
+void structures::ArrayList<T>::make_room(std::size_t count) {
+    if (max_size_ - size_ >= count) {
+        return;
+    } else if (!auto_grow_) {
         throw std::out_of_range("no space");
     } else {
-        contents[size_] = data;
-        size_++;
+        std::size_t max_size = max_size_ > 0 ? 2 * max_size_ : DEFAULT_MAX;
+        relocate(max_size < size_ + count ? size_ + count : max_size);
     }
 }
 
+// Trivially copyable elements are moved with a single memcpy, anything
+// else is move constructed one by one.
 template<typename T>
-void structures::ArrayList<T>::push_front(const T& data) {
-    if (full()) {
-        throw std::out_of_range("no space");
+void structures::ArrayList<T>::relocate(std::size_t max_size) {
+    T* moved = allocate(max_size);
+    if (std::is_trivially_copyable<T>::value) {
+        std::memcpy(static_cast<void*>(moved), static_cast<void*>(contents), size_ * sizeof(T));
     } else {
-        for (std::size_t i = size_; i > 0; i--) {
-            contents[i] = contents[i - 1];
+        for (std::size_t i = 0; i < size_; i++) {
+            new (moved + i) T(std::move(contents[i]));
+            contents[i].~T();
         }
-        contents[0] = data;
-        size_++;
     }
+    ::operator delete(contents);
+    contents = moved;
+    max_size_ = max_size;
 }
 
+// Moves [index, size_) count slots right in one pass and leaves
+// [index, index + count) as raw storage. Trivially copyable elements are
+// shifted with a single memmove; anything else is move constructed into
+// the raw slots past size_ and move assigned below it.
 template<typename T>
-void structures::ArrayList<T>::insert(const T& data, std::size_t index) {
-    if (full()) {
-        throw std::out_of_range("no space");
-    } else if (index < 0 || index > size_) {
-        throw std::out_of_range("invalid index");
+void structures::ArrayList<T>::open_gap(std::size_t index, std::size_t count) {
+    if (count == 0) {
+        return;
+    } else if (std::is_trivially_copyable<T>::value) {
+        std::memmove(static_cast<void*>(contents + index + count),
+                     static_cast<void*>(contents + index),
+                     (size_ - index) * sizeof(T));
     } else {
         for (std::size_t i = size_; i > index; i--) {
-            contents[i] = contents[i - 1];
+            if (i - 1 + count >= size_) {
+                new (contents + i - 1 + count) T(std::move(contents[i - 1]));
+            } else {
+                contents[i - 1 + count] = std::move(contents[i - 1]);
+            }
+        }
+        std::size_t end = index + count < size_ ? index + count : size_;
+        for (std::size_t i = index; i < end; i++) {
+            contents[i].~T();
+        }
+    }
+}
+
+// Moves [index + count, size_) count slots left over the elements in
+// [index, index + count) and destroys the count slots left at the end.
+template<typename T>
+void structures::ArrayList<T>::close_gap(std::size_t index, std::size_t count) {
+    if (count == 0) {
+        return;
+    } else if (std::is_trivially_copyable<T>::value) {
+        std::memmove(static_cast<void*>(contents + index),
+                     static_cast<void*>(contents + index + count),
+                     (size_ - index - count) * sizeof(T));
+    } else {
+        for (std::size_t i = index; i + count < size_; i++) {
+            contents[i] = std::move(contents[i + count]);
+        }
+        for (std::size_t i = size_ - count; i < size_; i++) {
+            contents[i].~T();
         }
-        contents[index] = data;
-        size_++;
     }
 }
 
+template<typename T>
+void structures::ArrayList<T>::push_back(const T& data) {
+    emplace_back(data);
+}
+
+template<typename T>
+void structures::ArrayList<T>::push_front(const T& data) {
+    insert(data, 0);
+}
+
+template<typename T>
+template<typename... Args>
+void structures::ArrayList<T>::emplace_back(Args&&... args) {
+    if (size_ < max_size_) {
+        new (contents + size_) T(std::forward<Args>(args)...);
+    } else {
+        // args may refer to an element, so build before growing.
+        T data(std::forward<Args>(args)...);
+        make_room();
+        new (contents + size_) T(std::move(data));
+    }
+    size_++;
+}
+
+template<typename T>
+template<typename... Args>
+void structures::ArrayList<T>::emplace(std::size_t index, Args&&... args) {
+    if (index > size_) {
+        throw std::out_of_range("invalid index");
+    } else if (index == size_) {
+        emplace_back(std::forward<Args>(args)...);
+        return;
+    }
+    // args may refer to an element, so build before growing or shifting.
+    T data(std::forward<Args>(args)...);
+    make_room();
+    open_gap(index, 1);
+    new (contents + index) T(std::move(data));
+    size_++;
+}
+
+// data is copied before the list grows or shifts, so it may refer to an
+// element of the list itself.
+template<typename T>
+void structures::ArrayList<T>::insert(const T& data, std::size_t index) {
+    emplace(index, data);
+}
+
+// Inserts count elements starting at data before index, shifting the tail
+// once for the whole batch. data must not point into this list.
+template<typename T>
+void structures::ArrayList<T>::insert_range(std::size_t index, const T* data, std::size_t count) {
+    if (index > size_) {
+        throw std::out_of_range("invalid index");
+    }
+    make_room(count);
+    open_gap(index, count);
+    for (std::size_t i = 0; i < count; i++) {
+        new (contents + index + i) T(data[i]);
+    }
+    size_ += count;
+}
+
+// Removes the elements in [first, last), shifting the tail once.
+template<typename T>
+void structures::ArrayList<T>::erase_range(std::size_t first, std::size_t last) {
+    if (first > last || last > size_) {
+        throw std::out_of_range("invalid index");
+    }
+    close_gap(first, last - first);
+    size_ -= last - first;
+}
+
 template<typename T>
 void structures::ArrayList<T>::insert_sorted(const T& data) {
-    if (full()) {
-        throw std::out_of_range("no space");
-    } else if (empty() || data > contents[size_ - 1]) {
+    if (empty() || data > contents[size_ - 1]) {
         push_back(data);
     } else {
-        std::size_t current;
-        current = 0;
-        while (data > contents[current]) {
-            current++;
-        }
-        insert(data, current);
+        insert(data, lower_bound(data));
     }
 }
 
@@ -172,11 +366,9 @@ T structures::ArrayList<T>::pop(std::size_t index) {
     } else if (empty()) {
         throw std::out_of_range("empty");
     } else {
-        T value = contents[index];
+        T value = std::move(contents[index]);
+        close_gap(index, 1);
         size_--;
-        for (std::size_t i = index; i < size_; i++) {
-            contents[i] = contents[i + 1];
-        }
         return value;
     }
 }
@@ -204,7 +396,7 @@ template<typename T>
 T& structures::ArrayList<T>::at(std::size_t index) {
     if (empty()) {
         throw std::out_of_range("empty");
-    } else if (index < 0 || index > size_) {
+    } else if (index >= size_) {
         throw std::out_of_range("invalid index");
     } else {
         return contents[index];
@@ -220,7 +412,7 @@ template<typename T>
 const T& structures::ArrayList<T>::at(std::size_t index) const {
     if (empty()) {
         throw std::out_of_range("empty");
-    } else if (index < 0 || index > size_) {
+    } else if (index >= size_) {
         throw std::out_of_range("invalid index");
     } else {
         return contents[index];
@@ -231,3 +423,25 @@ template<typename T>
 const T& structures::ArrayList<T>::operator[](std::size_t index) const {
     return contents[index];
 }
+
+template<typename T>
+typename structures::ArrayList<T>::iterator structures::ArrayList<T>::begin() {
+    return contents;
+}
+
+template<typename T>
+typename structures::ArrayList<T>::iterator structures::ArrayList<T>::end() {
+    return contents + size_;
+}
+
+template<typename T>
+typename structures::ArrayList<T>::const_iterator structures::ArrayList<T>::begin() const {
+    return contents;
+}
+
+template<typename T>
+typename structures::ArrayList<T>::const_iterator structures::ArrayList<T>::end() const {
+    return contents + size_;
+}
+
+#endif
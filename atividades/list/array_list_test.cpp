@@ -0,0 +1,82 @@
+// g++ -std=c++11 -Wall -g -fsanitize=address array_list_test.cpp && ./a.out
+//
+// Regression tests for ArrayList. Growing relocates the elements, so an
+// argument that refers to one of them must be used before the old storage
+// is released; AddressSanitizer reports it otherwise.
+
+#include <cassert>
+#include <cstdio>
+#include <string>
+
+#include "array_list.h"
+
+using namespace std;
+
+void test_push_back_self() {
+    structures::ArrayList<string> list(2, true);
+    list.push_back("a");
+    list.push_back("b");
+    list.push_back(list[0]);
+    assert(list.size() == 3 && list[2] == "a");
+}
+
+void test_emplace_back_self() {
+    structures::ArrayList<string> list(1, true);
+    list.push_back("ab");
+    list.emplace_back(list[0], 1);
+    assert(list.size() == 2 && list[1] == "b");
+}
+
+void test_emplace_self() {
+    structures::ArrayList<string> list(2, true);
+    list.push_back("a");
+    list.push_back("b");
+    list.emplace(1, list[1], 0);
+    assert(list.size() == 3 && list[1] == "b" && list[2] == "b");
+}
+
+void test_insert_sorted_self() {
+    structures::ArrayList<string> list(2, true);
+    list.insert_sorted("a");
+    list.insert_sorted("b");
+    list.insert_sorted(list[1]);
+    assert(list.size() == 3 && list[2] == "b");
+}
+
+void test_insert_bad_index() {
+    structures::ArrayList<string> list(1, true);
+    list.push_back("a");
+    try {
+        list.insert("b", 2);
+        assert(false);
+    } catch (std::out_of_range&) {
+    }
+    assert(list.size() == 1 && list.max_size() == 1);
+}
+
+void test_at_size() {
+    structures::ArrayList<string> list(2);
+    list.push_back("a");
+    const structures::ArrayList<string> &view = list;
+    try {
+        list.at(1);
+        assert(false);
+    } catch (std::out_of_range&) {
+    }
+    try {
+        view.at(1);
+        assert(false);
+    } catch (std::out_of_range&) {
+    }
+}
+
+int main() {
+    test_push_back_self();
+    test_emplace_back_self();
+    test_emplace_self();
+    test_insert_sorted_self();
+    test_insert_bad_index();
+    test_at_size();
+    printf("ok\n");
+    return 0;
+}
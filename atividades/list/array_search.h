@@ -0,0 +1,221 @@
+#ifndef STRUCTURES_ARRAY_SEARCH_H
+#define STRUCTURES_ARRAY_SEARCH_H
+
+#include <cstdint>
+#include <type_traits>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define STRUCTURES_SEARCH_X86
+#include <immintrin.h>
+#endif
+
+
+namespace structures {
+
+namespace search {
+
+// Types compared a whole vector at a time: integers and IEEE floats of
+// 1, 2, 4 or 8 bytes. Anything else goes through operator==.
+template<typename T>
+struct Vectorizable {
+    static const bool value = std::is_arithmetic<T>::value
+        && !std::is_same<T, bool>::value
+        && !std::is_same<T, long double>::value
+        && (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8);
+};
+
+template<typename T>
+std::size_t find_scalar(const T* data, std::size_t begin, std::size_t size, const T& value) {
+    for (std::size_t i = begin; i < size; i++) {
+        if (data[i] == value) {
+            return i;
+        }
+    }
+    return size;
+}
+
+template<typename T>
+std::size_t count_scalar(const T* data, std::size_t begin, std::size_t size, const T& value) {
+    std::size_t count = 0;
+    for (std::size_t i = begin; i < size; i++) {
+        count += data[i] == value;
+    }
+    return count;
+}
+
+#ifdef STRUCTURES_SEARCH_X86
+
+// The compare helpers return one bit per byte, so a match of a T sets
+// sizeof(T) consecutive bits. Floats use an ordered compare, which
+// matches operator== for NaN and signed zeros.
+template<typename T>
+__attribute__((target("avx2")))
+inline uint32_t equal_mask_avx2(__m256i block, __m256i needle) {
+    __m256i equal;
+    if (std::is_same<T, float>::value) {
+        equal = _mm256_castps_si256(_mm256_cmp_ps(
+            _mm256_castsi256_ps(block), _mm256_castsi256_ps(needle), _CMP_EQ_OQ));
+    } else if (std::is_same<T, double>::value) {
+        equal = _mm256_castpd_si256(_mm256_cmp_pd(
+            _mm256_castsi256_pd(block), _mm256_castsi256_pd(needle), _CMP_EQ_OQ));
+    } else if (sizeof(T) == 1) {
+        equal = _mm256_cmpeq_epi8(block, needle);
+    } else if (sizeof(T) == 2) {
+        equal = _mm256_cmpeq_epi16(block, needle);
+    } else if (sizeof(T) == 4) {
+        equal = _mm256_cmpeq_epi32(block, needle);
+    } else {
+        equal = _mm256_cmpeq_epi64(block, needle);
+    }
+    return uint32_t(_mm256_movemask_epi8(equal));
+}
+
+template<typename T>
+inline uint32_t equal_mask_sse2(__m128i block, __m128i needle) {
+    __m128i equal;
+    if (std::is_same<T, float>::value) {
+        equal = _mm_castps_si128(_mm_cmpeq_ps(_mm_castsi128_ps(block), _mm_castsi128_ps(needle)));
+    } else if (std::is_same<T, double>::value) {
+        equal = _mm_castpd_si128(_mm_cmpeq_pd(_mm_castsi128_pd(block), _mm_castsi128_pd(needle)));
+    } else if (sizeof(T) == 1) {
+        equal = _mm_cmpeq_epi8(block, needle);
+    } else if (sizeof(T) == 2) {
+        equal = _mm_cmpeq_epi16(block, needle);
+    } else if (sizeof(T) == 4) {
+        equal = _mm_cmpeq_epi32(block, needle);
+    } else {
+        // SSE2 has no 64-bit compare: both 32-bit halves must match.
+        equal = _mm_cmpeq_epi32(block, needle);
+        equal = _mm_and_si128(equal, _mm_shuffle_epi32(equal, _MM_SHUFFLE(2, 3, 0, 1)));
+    }
+    return uint32_t(_mm_movemask_epi8(equal));
+}
+
+template<typename T>
+void fill(T* lanes, std::size_t count, const T& value) {
+    for (std::size_t i = 0; i < count; i++) {
+        lanes[i] = value;
+    }
+}
+
+template<typename T>
+__attribute__((target("avx2")))
+std::size_t find_avx2(const T* data, std::size_t size, const T& value) {
+    const std::size_t lanes = 32 / sizeof(T);
+    T splat[lanes];
+    fill(splat, lanes, value);
+    const __m256i needle = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(splat));
+    std::size_t i = 0;
+    for (; i + lanes <= size; i += lanes) {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        uint32_t mask = equal_mask_avx2<T>(block, needle);
+        if (mask != 0) {
+            return i + __builtin_ctz(mask) / sizeof(T);
+        }
+    }
+    return find_scalar(data, i, size, value);
+}
+
+template<typename T>
+__attribute__((target("avx2")))
+std::size_t count_avx2(const T* data, std::size_t size, const T& value) {
+    const std::size_t lanes = 32 / sizeof(T);
+    T splat[lanes];
+    fill(splat, lanes, value);
+    const __m256i needle = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(splat));
+    std::size_t bits = 0;
+    std::size_t i = 0;
+    for (; i + lanes <= size; i += lanes) {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        bits += __builtin_popcount(equal_mask_avx2<T>(block, needle));
+    }
+    return bits / sizeof(T) + count_scalar(data, i, size, value);
+}
+
+template<typename T>
+std::size_t find_sse2(const T* data, std::size_t size, const T& value) {
+    const std::size_t lanes = 16 / sizeof(T);
+    T splat[lanes];
+    fill(splat, lanes, value);
+    const __m128i needle = _mm_loadu_si128(reinterpret_cast<const __m128i*>(splat));
+    std::size_t i = 0;
+    for (; i + lanes <= size; i += lanes) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        uint32_t mask = equal_mask_sse2<T>(block, needle);
+        if (mask != 0) {
+            return i + __builtin_ctz(mask) / sizeof(T);
+        }
+    }
+    return find_scalar(data, i, size, value);
+}
+
+template<typename T>
+std::size_t count_sse2(const T* data, std::size_t size, const T& value) {
+    const std::size_t lanes = 16 / sizeof(T);
+    T splat[lanes];
+    fill(splat, lanes, value);
+    const __m128i needle = _mm_loadu_si128(reinterpret_cast<const __m128i*>(splat));
+    std::size_t bits = 0;
+    std::size_t i = 0;
+    for (; i + lanes <= size; i += lanes) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        bits += __builtin_popcount(equal_mask_sse2<T>(block, needle));
+    }
+    return bits / sizeof(T) + count_scalar(data, i, size, value);
+}
+
+// Checked once; the answer does not change while the program runs.
+inline bool has_avx2() {
+    static const bool avx2 = __builtin_cpu_supports("avx2");
+    return avx2;
+}
+
+#endif
+
+// Index of the first element equal to value, or size when there is none.
+template<typename T>
+typename std::enable_if<Vectorizable<T>::value, std::size_t>::type
+find(const T* data, std::size_t size, const T& value) {
+#ifdef STRUCTURES_SEARCH_X86
+    if (has_avx2()) {
+        return find_avx2(data, size, value);
+    }
+#ifdef __SSE2__
+    return find_sse2(data, size, value);
+#endif
+#endif
+    return find_scalar(data, 0, size, value);
+}
+
+template<typename T>
+typename std::enable_if<!Vectorizable<T>::value, std::size_t>::type
+find(const T* data, std::size_t size, const T& value) {
+    return find_scalar(data, 0, size, value);
+}
+
+// Number of elements equal to value.
+template<typename T>
+typename std::enable_if<Vectorizable<T>::value, std::size_t>::type
+count(const T* data, std::size_t size, const T& value) {
+#ifdef STRUCTURES_SEARCH_X86
+    if (has_avx2()) {
+        return count_avx2(data, size, value);
+    }
+#ifdef __SSE2__
+    return count_sse2(data, size, value);
+#endif
+#endif
+    return count_scalar(data, 0, size, value);
+}
+
+template<typename T>
+typename std::enable_if<!Vectorizable<T>::value, std::size_t>::type
+count(const T* data, std::size_t size, const T& value) {
+    return count_scalar(data, 0, size, value);
+}
+
+}  // namespace search
+
+}  // namespace structures
+
+#endif
@@ -0,0 +1,59 @@
+// g++ -std=c++11 -Wall -O2 bench_search.cpp -o bench_search.out && ./bench_search.out
+//
+// Times find and count on arrays of 1K to 100M elements, the scalar loop
+// against the SIMD version picked at run time.
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+#include "array_list.h"
+
+using namespace std;
+using namespace structures::search;
+
+volatile std::size_t sink;
+
+// Average time of one call of f, in microseconds.
+template<typename F>
+double micros(F f, int rounds) {
+    auto begin = chrono::steady_clock::now();
+    for (int i = 0; i < rounds; i++) {
+        f();
+    }
+    chrono::duration<double, micro> elapsed = chrono::steady_clock::now() - begin;
+    return elapsed.count() / rounds;
+}
+
+int rounds_for(std::size_t n) {
+    return n <= 100000 ? 2000 : n <= 10000000 ? 10 : 3;
+}
+
+// The needle of find is missing, so every call scans the whole array.
+template<typename T>
+void search(const char* type, std::size_t n) {
+    vector<T> data(n);
+    for (std::size_t i = 0; i < n; i++) {
+        data[i] = T(i % 1000);
+    }
+    const T missing = T(-1);
+    const T present = T(7);
+    int rounds = rounds_for(n);
+
+    double find_s = micros([&] { sink = find_scalar(data.data(), 0, n, missing); }, rounds);
+    double find_v = micros([&] { sink = find(data.data(), n, missing); }, rounds);
+    double count_s = micros([&] { sink = count_scalar(data.data(), 0, n, present); }, rounds);
+    double count_v = micros([&] { sink = count(data.data(), n, present); }, rounds);
+    printf("%-6s n=%-10zu find %10.1f -> %10.1f us   count %10.1f -> %10.1f us\n",
+           type, n, find_s, find_v, count_s, count_v);
+}
+
+int main() {
+    std::size_t sizes[] = {1000, 100000, 10000000, 100000000};
+    for (std::size_t n : sizes) {
+        search<int>("int", n);
+    }
+    search<float>("float", 1000);
+    search<float>("float", 10000000);
+    return 0;
+}
@@ -0,0 +1,74 @@
+// g++ -std=c++11 -Wall -O2 bench_shift.cpp -o bench_shift.out && ./bench_shift.out
+//
+// Times the edits that shift the tail of an ArrayList: push_front, pop
+// from the middle and batched insert_range/erase_range.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#include "array_list.h"
+
+using namespace std;
+
+template<typename F>
+double seconds(F f) {
+    auto begin = chrono::steady_clock::now();
+    f();
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - begin;
+    return elapsed.count();
+}
+
+void report(const char* label, double secs) {
+    printf("%-36s %9.3f ms\n", label, secs * 1e3);
+}
+
+template<typename T, typename Make>
+void shifts(const char* type, int n, Make make) {
+    structures::ArrayList<T> list(n, true);
+    char label[64];
+
+    snprintf(label, sizeof(label), "%s push_front x%d", type, n);
+    report(label, seconds([&] {
+        for (int i = 0; i < n; i++) {
+            list.push_front(make(i));
+        }
+    }));
+
+    snprintf(label, sizeof(label), "%s middle pop x%d", type, n);
+    report(label, seconds([&] {
+        while (!list.empty()) {
+            list.pop(list.size() / 2);
+        }
+    }));
+}
+
+// Same element count as shifts, moved 64 at a time.
+void ranges(int n) {
+    int chunk[64];
+    for (int i = 0; i < 64; i++) {
+        chunk[i] = i;
+    }
+    structures::ArrayList<int> list(n, true);
+    char label[64];
+    snprintf(label, sizeof(label), "int insert/erase_range x%d", n / 64);
+    report(label, seconds([&] {
+        for (int i = 0; i < n / 64; i++) {
+            list.insert_range(0, chunk, 64);
+        }
+        while (!list.empty()) {
+            std::size_t first = list.size() / 2;
+            std::size_t last = first + 64 < list.size() ? first + 64 : list.size();
+            list.erase_range(first, last);
+        }
+    }));
+}
+
+int main(int argc, char* argv[]) {
+    int n = argc > 1 ? atoi(argv[1]) : 100000;
+    shifts<int>("int", n, [](int i) { return i; });
+    shifts<string>("string", n / 8, [](int i) { return to_string(i); });
+    ranges(n);
+    return 0;
+}
@@ -0,0 +1,295 @@
+#ifndef STRUCTURES_GAP_LIST_H
+#define STRUCTURES_GAP_LIST_H
+
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+
+namespace structures {
+
+// List with the ArrayList interface whose free slots form a gap that
+// follows the last edit. Elements live in [0, gap_begin_) and
+// [gap_end_, max_size_); an insert or pop at the gap only moves its
+// boundary, and the gap is carried to a new position only when an edit
+// lands elsewhere, moving just the elements in between.
+template<typename T>
+class GapList {
+ public:
+    GapList();
+    explicit GapList(std::size_t max_size);
+    ~GapList();
+
+    void clear();
+    void push_back(const T& data);
+    void push_front(const T& data);
+    void insert(const T& data, std::size_t index);
+    T pop(std::size_t index);
+    T pop_back();
+    T pop_front();
+    void remove(const T& data);
+    bool empty() const;
+    bool contains(const T& data) const;
+    std::size_t find(const T& data) const;
+    std::size_t size() const;
+    std::size_t max_size() const;
+    T& at(std::size_t index);
+    T& operator[](std::size_t index);
+    const T& at(std::size_t index) const;
+    const T& operator[](std::size_t index) const;
+
+ private:
+    static T* allocate(std::size_t max_size);
+    std::size_t slot(std::size_t index) const;
+    void move_gap(std::size_t index);
+    void make_room();
+
+    // Slots inside [gap_begin_, gap_end_) are raw storage.
+    T* contents;
+    std::size_t gap_begin_;
+    std::size_t gap_end_;
+    std::size_t max_size_;
+
+    static const auto DEFAULT_MAX = 10u;
+};
+
+}  // namespace structures
+
+template<typename T>
+structures::GapList<T>::GapList() {
+    max_size_ = DEFAULT_MAX;
+    contents = allocate(max_size_);
+    gap_begin_ = 0;
+    gap_end_ = max_size_;
+}
+
+template<typename T>
+structures::GapList<T>::GapList(std::size_t max_size) {
+    max_size_ = max_size;
+    contents = allocate(max_size_);
+    gap_begin_ = 0;
+    gap_end_ = max_size_;
+}
+
+template<typename T>
+structures::GapList<T>::~GapList() {
+    clear();
+    ::operator delete(contents);
+}
+
+template<typename T>
+T* structures::GapList<T>::allocate(std::size_t max_size) {
+    return static_cast<T*>(::operator new(max_size * sizeof(T)));
+}
+
+template<typename T>
+void structures::GapList<T>::clear() {
+    for (std::size_t i = 0; i < gap_begin_; i++) {
+        contents[i].~T();
+    }
+    for (std::size_t i = gap_end_; i < max_size_; i++) {
+        contents[i].~T();
+    }
+    gap_begin_ = 0;
+    gap_end_ = max_size_;
+}
+
+template<typename T>
+std::size_t structures::GapList<T>::slot(std::size_t index) const {
+    return index < gap_begin_ ? index : index + (gap_end_ - gap_begin_);
+}
+
+// Places the gap right before the element at index, moving only the
+// elements between the old and the new position.
+template<typename T>
+void structures::GapList<T>::move_gap(std::size_t index) {
+    if (gap_begin_ == gap_end_) {
+        gap_begin_ = index;
+        gap_end_ = index;
+    } else if (index < gap_begin_) {
+        std::size_t count = gap_begin_ - index;
+        if (std::is_trivially_copyable<T>::value) {
+            std::memmove(static_cast<void*>(contents + gap_end_ - count),
+                         static_cast<void*>(contents + index), count * sizeof(T));
+        } else {
+            for (std::size_t i = gap_begin_; i > index; i--) {
+                new (contents + gap_end_ - (gap_begin_ - i) - 1) T(std::move(contents[i - 1]));
+                contents[i - 1].~T();
+            }
+        }
+        gap_begin_ -= count;
+        gap_end_ -= count;
+    } else if (index > gap_begin_) {
+        std::size_t count = index - gap_begin_;
+        if (std::is_trivially_copyable<T>::value) {
+            std::memmove(static_cast<void*>(contents + gap_begin_),
+                         static_cast<void*>(contents + gap_end_), count * sizeof(T));
+        } else {
+            for (std::size_t i = 0; i < count; i++) {
+                new (contents + gap_begin_ + i) T(std::move(contents[gap_end_ + i]));
+                contents[gap_end_ + i].~T();
+            }
+        }
+        gap_begin_ += count;
+        gap_end_ += count;
+    }
+}
+
+// A full list doubles its storage, keeping the gap where it was.
+template<typename T>
+void structures::GapList<T>::make_room() {
+    if (gap_begin_ != gap_end_) {
+        return;
+    }
+    std::size_t max_size = max_size_ > 0 ? 2 * max_size_ : DEFAULT_MAX;
+    std::size_t tail = max_size_ - gap_end_;
+    T* moved = allocate(max_size);
+    if (std::is_trivially_copyable<T>::value) {
+        std::memcpy(static_cast<void*>(moved), static_cast<void*>(contents),
+                    gap_begin_ * sizeof(T));
+        std::memcpy(static_cast<void*>(moved + max_size - tail),
+                    static_cast<void*>(contents + gap_end_), tail * sizeof(T));
+    } else {
+        for (std::size_t i = 0; i < gap_begin_; i++) {
+            new (moved + i) T(std::move(contents[i]));
+            contents[i].~T();
+        }
+        for (std::size_t i = 0; i < tail; i++) {
+            new (moved + max_size - tail + i) T(std::move(contents[gap_end_ + i]));
+            contents[gap_end_ + i].~T();
+        }
+    }
+    ::operator delete(contents);
+    contents = moved;
+    gap_end_ = max_size - tail;
+    max_size_ = max_size;
+}
+
+template<typename T>
+void structures::GapList<T>::push_back(const T& data) {
+    insert(data, size());
+}
+
+template<typename T>
+void structures::GapList<T>::push_front(const T& data) {
+    insert(data, 0);
+}
+
+template<typename T>
+void structures::GapList<T>::insert(const T& data, std::size_t index) {
+    if (index > size()) {
+        throw std::out_of_range("invalid index");
+    } else {
+        T element(data);
+        make_room();
+        move_gap(index);
+        new (contents + gap_begin_) T(std::move(element));
+        gap_begin_++;
+    }
+}
+
+template<typename T>
+T structures::GapList<T>::pop(std::size_t index) {
+    if (empty()) {
+        throw std::out_of_range("empty");
+    } else if (index >= size()) {
+        throw std::out_of_range("invalid index");
+    } else {
+        move_gap(index);
+        T value = std::move(contents[gap_end_]);
+        contents[gap_end_].~T();
+        gap_end_++;
+        return value;
+    }
+}
+
+template<typename T>
+T structures::GapList<T>::pop_back() {
+    return pop(size() - 1);
+}
+
+template<typename T>
+T structures::GapList<T>::pop_front() {
+    return pop(0);
+}
+
+template<typename T>
+void structures::GapList<T>::remove(const T& data) {
+    if (empty()) {
+        throw std::out_of_range("empty");
+    } else {
+        pop(find(data));
+    }
+}
+
+template<typename T>
+bool structures::GapList<T>::empty() const {
+    return size() == 0;
+}
+
+template<typename T>
+bool structures::GapList<T>::contains(const T& data) const {
+    return find(data) != size();
+}
+
+template<typename T>
+std::size_t structures::GapList<T>::find(const T& data) const {
+    for (std::size_t i = 0; i < gap_begin_; i++) {
+        if (contents[i] == data) {
+            return i;
+        }
+    }
+    for (std::size_t i = gap_end_; i < max_size_; i++) {
+        if (contents[i] == data) {
+            return i - (gap_end_ - gap_begin_);
+        }
+    }
+    return size();
+}
+
+template<typename T>
+std::size_t structures::GapList<T>::size() const {
+    return max_size_ - (gap_end_ - gap_begin_);
+}
+
+template<typename T>
+std::size_t structures::GapList<T>::max_size() const {
+    return max_size_;
+}
+
+template<typename T>
+T& structures::GapList<T>::at(std::size_t index) {
+    if (empty()) {
+        throw std::out_of_range("empty");
+    } else if (index >= size()) {
+        throw std::out_of_range("invalid index");
+    } else {
+        return contents[slot(index)];
+    }
+}
+
+template<typename T>
+T& structures::GapList<T>::operator[](std::size_t index) {
+    return contents[slot(index)];
+}
+
+template<typename T>
+const T& structures::GapList<T>::at(std::size_t index) const {
+    if (empty()) {
+        throw std::out_of_range("empty");
+    } else if (index >= size()) {
+        throw std::out_of_range("invalid index");
+    } else {
+        return contents[slot(index)];
+    }
+}
+
+template<typename T>
+const T& structures::GapList<T>::operator[](std::size_t index) const {
+    return contents[slot(index)];
+}
+
+#endif
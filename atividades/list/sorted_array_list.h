@@ -0,0 +1,142 @@
+#ifndef STRUCTURES_SORTED_ARRAY_LIST_H
+#define STRUCTURES_SORTED_ARRAY_LIST_H
+
+#include <cstdint>
+#include <stdexcept>
+
+#include "array_list.h"
+
+
+namespace structures {
+
+// ArrayList that keeps its elements in ascending order, so lookups are
+// binary searches instead of linear scans. Elements are only added
+// through insert() and are read-only, which keeps the order intact.
+template<typename T>
+class SortedArrayList {
+ public:
+    SortedArrayList();
+    explicit SortedArrayList(std::size_t max_size);
+
+    void clear();
+    void insert(const T& data);
+    T pop(std::size_t index);
+    T pop_back();
+    T pop_front();
+    void remove(const T& data);
+    bool empty() const;
+    bool contains(const T& data) const;
+    std::size_t find(const T& data) const;
+    std::size_t lower_bound(const T& data) const;
+    std::size_t upper_bound(const T& data) const;
+    std::size_t count(const T& low, const T& high) const;
+    std::size_t size() const;
+    const T& at(std::size_t index) const;
+    const T& operator[](std::size_t index) const;
+
+ private:
+    ArrayList<T> list;
+
+    static const auto DEFAULT_MAX = 10u;
+};
+
+}  // namespace structures
+
+template<typename T>
+structures::SortedArrayList<T>::SortedArrayList():
+    list(DEFAULT_MAX, true)
+{}
+
+template<typename T>
+structures::SortedArrayList<T>::SortedArrayList(std::size_t max_size):
+    list(max_size, true)
+{}
+
+template<typename T>
+void structures::SortedArrayList<T>::clear() {
+    list.clear();
+}
+
+// Equal elements keep their insertion order.
+template<typename T>
+void structures::SortedArrayList<T>::insert(const T& data) {
+    list.insert(data, list.upper_bound(data));
+}
+
+template<typename T>
+T structures::SortedArrayList<T>::pop(std::size_t index) {
+    return list.pop(index);
+}
+
+template<typename T>
+T structures::SortedArrayList<T>::pop_back() {
+    return list.pop_back();
+}
+
+template<typename T>
+T structures::SortedArrayList<T>::pop_front() {
+    return list.pop_front();
+}
+
+template<typename T>
+void structures::SortedArrayList<T>::remove(const T& data) {
+    if (empty()) {
+        throw std::out_of_range("empty");
+    } else {
+        list.pop(find(data));
+    }
+}
+
+template<typename T>
+bool structures::SortedArrayList<T>::empty() const {
+    return list.empty();
+}
+
+template<typename T>
+bool structures::SortedArrayList<T>::contains(const T& data) const {
+    return find(data) != size();
+}
+
+template<typename T>
+std::size_t structures::SortedArrayList<T>::find(const T& data) const {
+    std::size_t i = list.lower_bound(data);
+    if (i < size() && list[i] == data) {
+        return i;
+    }
+    return size();
+}
+
+template<typename T>
+std::size_t structures::SortedArrayList<T>::lower_bound(const T& data) const {
+    return list.lower_bound(data);
+}
+
+template<typename T>
+std::size_t structures::SortedArrayList<T>::upper_bound(const T& data) const {
+    return list.upper_bound(data);
+}
+
+// Number of elements in [low, high].
+template<typename T>
+std::size_t structures::SortedArrayList<T>::count(const T& low, const T& high) const {
+    std::size_t first = list.lower_bound(low);
+    std::size_t last = list.upper_bound(high);
+    return last > first ? last - first : 0;
+}
+
+template<typename T>
+std::size_t structures::SortedArrayList<T>::size() const {
+    return list.size();
+}
+
+template<typename T>
+const T& structures::SortedArrayList<T>::at(std::size_t index) const {
+    return list.at(index);
+}
+
+template<typename T>
+const T& structures::SortedArrayList<T>::operator[](std::size_t index) const {
+    return list[index];
+}
+
+#endif
@@ -2,7 +2,9 @@
 #define STRUCTURES_ARRAY_QUEUE_H
 
 #include <cstdint>
+#include <new>
 #include <stdexcept>
+#include <utility>
 
 namespace structures {
 
@@ -13,6 +15,8 @@ class ArrayQueue {
     explicit ArrayQueue(std::size_t max);
     ~ArrayQueue();
     void enqueue(const T& data);
+    template<typename... Args>
+    void emplace(Args&&... args);
     T dequeue();
     T& back();
     void clear();
@@ -22,6 +26,10 @@ class ArrayQueue {
     bool full();
 
  private:
+    int next(int index);
+
+    // Circular buffer: the size_ slots after begin_ hold constructed
+    // elements, the rest is raw storage.
     T* contents;
     std::size_t size_;
     std::size_t max_size_;
@@ -38,7 +46,7 @@ class ArrayQueue {
 template<typename T>
 structures::ArrayQueue<T>::ArrayQueue() {
     max_size_ = DEFAULT_SIZE;
-    contents = new T[max_size_];
+    contents = static_cast<T*>(::operator new(max_size_ * sizeof(T)));
     size_ = 0;
     begin_ = -1;
     end_ = -1;
@@ -47,7 +55,7 @@ structures::ArrayQueue<T>::ArrayQueue() {
 template<typename T>
 structures::ArrayQueue<T>::ArrayQueue(std::size_t max) {
     max_size_ = max;
-    contents = new T[max_size_];
+    contents = static_cast<T*>(::operator new(max_size_ * sizeof(T)));
     size_ = 0;
     begin_ = -1;
     end_ = -1;
@@ -55,7 +63,13 @@ structures::ArrayQueue<T>::ArrayQueue(std::size_t max) {
 
 template<typename T>
 structures::ArrayQueue<T>::~ArrayQueue() {
-    delete[] contents;
+    clear();
+    ::operator delete(contents);
+}
+
+template<typename T>
+int structures::ArrayQueue<T>::next(int index) {
+    return (index + 1) % static_cast<int>(max_size_);
 }
 
 template<typename T>
@@ -63,8 +77,21 @@ void structures::ArrayQueue<T>::enqueue(const T& data) {
     if (full()) {
         throw std::out_of_range("cheio");
     } else {
+        new (contents + next(end_)) T(data);
+        end_ = next(end_);
+        size_++;
+    }
+}
+
+template<typename T>
+template<typename... Args>
+void structures::ArrayQueue<T>::emplace(Args&&... args) {
+    if (full()) {
+        throw std::out_of_range("cheio");
+    } else {
+        new (contents + next(end_)) T(std::forward<Args>(args)...);
+        end_ = next(end_);
         size_++;
-        contents[++end_] = data;
     }
 }
 
@@ -74,8 +101,11 @@ T structures::ArrayQueue<T>::dequeue() {
     if (empty()) {
         throw std::out_of_range("vazio");
     } else {
+        begin_ = next(begin_);
+        T element = std::move(contents[begin_]);
+        contents[begin_].~T();
         size_--;
-        return contents[++begin_];
+        return element;
     }
 }
 
@@ -90,11 +120,13 @@ T& structures::ArrayQueue<T>::back() {
 
 template<typename T>
 void structures::ArrayQueue<T>::clear() {
+    while (size_ > 0) {
+        begin_ = next(begin_);
+        contents[begin_].~T();
+        size_--;
+    }
     begin_ = -1;
     end_ = -1;
-    size_ = 0;
-    delete[] contents;
-    contents = new T[max_size_];
 }
 
 template<typename T>
@@ -2,7 +2,9 @@
 #define STRUCTURES_ARRAY_STACK_H
 
 #include <cstdint>
+#include <new>
 #include <stdexcept>
+#include <utility>
 
 namespace structures {
 template<typename T>
@@ -12,6 +14,8 @@ class ArrayStack {
     explicit ArrayStack(std::size_t max);
     ~ArrayStack();
     void push(const T& data);
+    template<typename... Args>
+    void emplace(Args&&... args);
     T pop();
     T& top();
     void clear();
@@ -20,6 +24,7 @@ class ArrayStack {
     bool empty();
     bool full();
  private:
+    // Slots above top_ are raw storage.
     T* contents;
     int top_;
     std::size_t max_size_;
@@ -34,20 +39,21 @@ class ArrayStack {
 template<typename T>
 structures::ArrayStack<T>::ArrayStack() {
     max_size_ = DEFAULT_SIZE;
-    contents = new T[max_size_];
+    contents = static_cast<T*>(::operator new(max_size_ * sizeof(T)));
     top_ = -1;
 }
 
 template<typename T>
 structures::ArrayStack<T>::ArrayStack(std::size_t max) {
     max_size_ = max;
-    contents = new T[max_size_];
+    contents = static_cast<T*>(::operator new(max_size_ * sizeof(T)));
     top_ = -1;
 }
 
 template<typename T>
 structures::ArrayStack<T>::~ArrayStack() {
-    delete[] contents;
+    clear();
+    ::operator delete(contents);
 }
 
 template<typename T>
@@ -55,7 +61,19 @@ void structures::ArrayStack<T>::push(const T& data) {
     if (full()) {
         throw std::out_of_range("Pilha cheia");
     } else {
-        contents[++top_] = data;
+        new (contents + top_ + 1) T(data);
+        top_++;
+    }
+}
+
+template<typename T>
+template<typename... Args>
+void structures::ArrayStack<T>::emplace(Args&&... args) {
+    if (full()) {
+        throw std::out_of_range("Pilha cheia");
+    } else {
+        new (contents + top_ + 1) T(std::forward<Args>(args)...);
+        top_++;
     }
 }
 
@@ -64,7 +82,8 @@ T structures::ArrayStack<T>::pop() {
     if (empty()) {
         throw std::out_of_range("Pilha vazia");
     } else {
-        T element = contents[top_--];
+        T element = std::move(contents[top_]);
+        contents[top_--].~T();
         return element;
     }
 }
@@ -76,7 +95,9 @@ T& structures::ArrayStack<T>::top() {
 
 template<typename T>
 void structures::ArrayStack<T>::clear() {
-    top_ = -1;
+    while (top_ >= 0) {
+        contents[top_--].~T();
+    }
 }
 
 template<typename T>
@@ -0,0 +1,55 @@
+// g++ -std=c++11 -Wall -O2 bench_index.cpp -o bench_index.out && ./bench_index.out
+//
+// Times contains on a list of 1M strings, scanning the list against
+// looking it up in the hash index. Half of the lookups miss.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#include "string_list.h"
+
+using namespace std;
+
+template<typename F>
+double seconds(F f) {
+    auto begin = chrono::steady_clock::now();
+    f();
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - begin;
+    return elapsed.count();
+}
+
+void key(char* buffer, std::size_t size, int i) {
+    snprintf(buffer, size, "customer/%07d/profile", i);
+}
+
+std::size_t lookups(structures::ArrayListString &list, int n, int queries) {
+    char buffer[48];
+    std::size_t hits = 0;
+    for (int q = 0; q < queries; q++) {
+        key(buffer, sizeof(buffer), (q * 7919) % n + (q % 2 ? n : 0));
+        hits += list.contains(buffer);
+    }
+    return hits;
+}
+
+int main(int argc, char* argv[]) {
+    int n = argc > 1 ? atoi(argv[1]) : 1000000;
+    char buffer[48];
+    structures::ArrayListString list(n);
+    for (int i = 0; i < n; i++) {
+        key(buffer, sizeof(buffer), i);
+        list.push_back(buffer);
+    }
+
+    std::size_t hits = 0;
+    double linear = seconds([&] { hits += lookups(list, n, 100); });
+    printf("%-28s %9.3f us per lookup\n", "linear contains", linear * 1e6 / 100);
+
+    list.use_index(true);
+    double rebuild = seconds([&] { list.contains(""); });
+    printf("%-28s %9.3f ms\n", "index rebuild", rebuild * 1e3);
+    double indexed = seconds([&] { hits += lookups(list, n, 100000); });
+    printf("%-28s %9.3f us per lookup\n", "indexed contains", indexed * 1e6 / 100000);
+    return hits == 0;
+}
@@ -4,6 +4,7 @@
 #include <cstdint>
 #include <stdexcept>  // C++ exceptions
 #include <cstring>
+#include <type_traits>
 
 
 namespace structures {
@@ -41,7 +42,26 @@ class ArrayList {
     static const auto DEFAULT_MAX = 10u;
 };
 
-class ArrayListString : public ArrayList<char *> {
+// Where a string of an ArrayListString lives: strings shorter than
+// local hold their characters and '\0' in the entry itself, longer ones
+// sit at offset in the arena. Length and hash reject most mismatches
+// without touching the characters.
+struct StringEntry {
+    uint32_t length;
+    uint32_t hash;
+    union {
+        std::size_t offset;
+        char local[16];
+    };
+};
+
+// Long strings live in one append-only arena, each followed by its '\0',
+// and short ones inside their entries, so most strings never leave the
+// list's own array. Removed long strings leave garbage in the arena
+// until compact() is called. Pointers returned by at() are valid until
+// the next insertion, removal or compaction. use_index(true) makes find
+// and contains hash lookups.
+class ArrayListString : public ArrayList<StringEntry> {
  public:
     ArrayListString() : ArrayList() {}
     explicit ArrayListString(std::size_t max_size) : ArrayList(max_size) {}
@@ -57,6 +77,35 @@ class ArrayListString : public ArrayList<char *> {
     void remove(const char *data);
     bool contains(const char *data);
     std::size_t find(const char *data);
+    const char *at(std::size_t index) const;
+    const char *operator[](std::size_t index) const;
+    std::size_t garbage() const;
+    void compact();
+    void use_index(bool enabled);
+
+ private:
+    const char *chars(const StringEntry& entry) const;
+    std::size_t append(const char *data, std::size_t length);
+    void erase(std::size_t index);
+    bool matches(const StringEntry& entry, const char *data,
+                 std::size_t length, uint32_t hash) const;
+    std::size_t probe(const char *data, std::size_t length, uint32_t hash) const;
+    void index_entry(std::size_t index);
+    void rebuild_index();
+
+    char* arena_{nullptr};
+    std::size_t arena_size_{0};
+    std::size_t arena_max_size_{0};
+    std::size_t garbage_{0};
+
+    // Open addressing table of position + 1, 0 marking a free slot.
+    std::size_t* index_{nullptr};
+    std::size_t index_max_size_{0};
+    bool indexed_{false};
+    // Set by edits other than push_back; the next lookup rebuilds.
+    bool index_stale_{true};
+
+    static const auto DEFAULT_ARENA = 256u;
 };
 
 }  // namespace structures
@@ -69,6 +118,15 @@ char* move_strbuffer(const char * data) {
     return newdata;
 }
 
+// 32-bit FNV-1a.
+uint32_t hash_string(const char * data, std::size_t length) {
+    uint32_t hash = 2166136261u;
+    for (std::size_t i = 0; i < length; i++) {
+        hash = (hash ^ static_cast<unsigned char>(data[i])) * 16777619u;
+    }
+    return hash;
+}
+
 template<typename T>
 structures::ArrayList<T>::ArrayList() {
     size_ = 0;
@@ -150,11 +208,7 @@ void structures::ArrayList<T>::push_front(const T& data) {
     if (full()) {
         throw std::out_of_range("no space");
     } else {
-        for (std::size_t i = size_; i > 0; i--) {
-            contents[i] = contents[i - 1];
-        }
-        contents[0] = data;
-        size_++;
+        insert(data, 0);
     }
 }
 
@@ -164,6 +218,11 @@ void structures::ArrayList<T>::insert(const T& data, std::size_t index) {
         throw std::out_of_range("no space");
     } else if (index < 0 || index > size_) {
         throw std::out_of_range("invalid index");
+    } else if (std::is_trivially_copyable<T>::value) {
+        std::memmove(static_cast<void*>(contents + index + 1),
+                     static_cast<void*>(contents + index), (size_ - index) * sizeof(T));
+        contents[index] = data;
+        size_++;
     } else {
         for (std::size_t i = size_; i > index; i--) {
             contents[i] = contents[i - 1];
@@ -198,8 +257,13 @@ T structures::ArrayList<T>::pop(std::size_t index) {
     } else {
         T value = contents[index];
         size_--;
-        for (std::size_t i = index; i < size_; i++) {
-            contents[i] = contents[i + 1];
+        if (std::is_trivially_copyable<T>::value) {
+            std::memmove(static_cast<void*>(contents + index),
+                         static_cast<void*>(contents + index + 1), (size_ - index) * sizeof(T));
+        } else {
+            for (std::size_t i = index; i < size_; i++) {
+                contents[i] = contents[i + 1];
+            }
         }
         return value;
     }
@@ -257,44 +321,115 @@ const T& structures::ArrayList<T>::operator[](std::size_t index) const {
 }
 
 structures::ArrayListString::~ArrayListString() {
-    for (std::size_t i = 0; i < size_; i++) {
-        delete[] contents[i];
-    }
+    delete[] arena_;
+    delete[] index_;
 }
 
 void structures::ArrayListString::clear() {
-    for (std::size_t i = 0; i < size_; i++) {
-        delete[] contents[i];
-    }
-    ArrayList<char*>::clear();
+    ArrayList<StringEntry>::clear();
+    arena_size_ = 0;
+    garbage_ = 0;
+    index_stale_ = true;
 }
 
+const char* structures::ArrayListString::chars(const StringEntry& entry) const {
+    return entry.length < sizeof(entry.local) ? entry.local : arena_ + entry.offset;
+}
+
+// Copies data and its '\0' to the end of the arena, doubling it when
+// needed. data may point into the arena itself, so the old block is only
+// released after the copy.
+std::size_t structures::ArrayListString::append(const char *data, std::size_t length) {
+    std::size_t offset = arena_size_;
+    if (arena_size_ + length + 1 > arena_max_size_) {
+        std::size_t max_size = arena_max_size_ > 0 ? 2 * arena_max_size_ : DEFAULT_ARENA;
+        while (max_size < arena_size_ + length + 1) {
+            max_size *= 2;
+        }
+        char* moved = new char[max_size];
+        if (arena_size_ > 0) {
+            std::memcpy(moved, arena_, arena_size_);
+        }
+        std::memcpy(moved + offset, data, length + 1);
+        delete[] arena_;
+        arena_ = moved;
+        arena_max_size_ = max_size;
+    } else {
+        std::memcpy(arena_ + offset, data, length + 1);
+    }
+    arena_size_ += length + 1;
+    return offset;
+}
 
 void structures::ArrayListString::push_back(const char* data) {
-    ArrayList<char*>::push_back(move_strbuffer(data));
+    insert(data, size_);
 }
 
 void structures::ArrayListString::push_front(const char* data) {
-    ArrayList<char*>::push_front(move_strbuffer(data));
+    insert(data, 0);
 }
 
 void structures::ArrayListString::insert(const char* data, std::size_t index) {
-    ArrayList<char*>::insert(move_strbuffer(data), index);
+    if (full()) {
+        throw std::out_of_range("no space");
+    } else if (index > size_) {
+        throw std::out_of_range("invalid index");
+    } else {
+        StringEntry entry;
+        entry.length = static_cast<uint32_t>(strlen(data));
+        entry.hash = hash_string(data, entry.length);
+        if (entry.length < sizeof(entry.local)) {
+            std::memcpy(entry.local, data, entry.length + 1);
+        } else {
+            entry.offset = append(data, entry.length);
+        }
+        ArrayList<StringEntry>::insert(entry, index);
+        if (index == size_ - 1 && !index_stale_) {
+            index_entry(index);
+        } else {
+            index_stale_ = true;
+        }
+    }
 }
 
+// Ordering needs the characters, so the hash does not help here; a binary
+// search keeps the strcmp calls to log n.
 void structures::ArrayListString::insert_sorted(const char* data) {
-    std::size_t index = 0;
-    while (index < size_ && strcmp(move_strbuffer(data), contents[index]) > 0) {
-        index++;
+    std::size_t first = 0;
+    std::size_t last = size_;
+    while (first < last) {
+        std::size_t middle = first + (last - first) / 2;
+        if (strcmp(data, chars(contents[middle])) > 0) {
+            first = middle + 1;
+        } else {
+            last = middle;
+        }
     }
 
-    insert(data, index);
+    insert(data, first);
+}
+
+// Drops the entry; a long string's bytes stay in the arena until
+// compact().
+void structures::ArrayListString::erase(std::size_t index) {
+    StringEntry entry = ArrayList<StringEntry>::pop(index);
+    if (entry.length >= sizeof(entry.local)) {
+        garbage_ += entry.length + 1;
+    }
+    index_stale_ = true;
 }
 
+// The returned copy belongs to the caller.
 char* structures::ArrayListString::pop(std::size_t index) {
-    char* data = ArrayList<char*>::pop(index);
-    char* newdata = move_strbuffer(data);
-    return newdata;
+    if (empty()) {
+        throw std::out_of_range("empty");
+    } else if (index >= size_) {
+        throw std::out_of_range("invalid index");
+    } else {
+        char* data = move_strbuffer(chars(contents[index]));
+        erase(index);
+        return data;
+    }
 }
 
 char* structures::ArrayListString::pop_back() {
@@ -305,10 +440,24 @@ char* structures::ArrayListString::pop_front() {
     return pop(0);
 }
 
+bool structures::ArrayListString::matches(const StringEntry& entry, const char *data,
+                                          std::size_t length, uint32_t hash) const {
+    return entry.hash == hash && entry.length == length
+        && std::memcmp(chars(entry), data, length) == 0;
+}
+
 std::size_t structures::ArrayListString::find(const char *data) {
+    std::size_t length = strlen(data);
+    uint32_t hash = hash_string(data, length);
+    if (indexed_) {
+        if (index_stale_) {
+            rebuild_index();
+        }
+        return probe(data, length, hash);
+    }
     std::size_t i = 0;
     while (i < size_) {
-        if (strcmp(contents[i], data) == 0) {
+        if (matches(contents[i], data, length, hash)) {
             break;
         }
         i++;
@@ -317,16 +466,102 @@ std::size_t structures::ArrayListString::find(const char *data) {
 }
 
 void structures::ArrayListString::remove(const char *data) {
-    pop(find(data));
+    std::size_t index = find(data);
+    if (index == size_) {
+        throw std::out_of_range("invalid index");
+    }
+    erase(index);
 }
 
 bool structures::ArrayListString::contains(const char *data) {
-    bool found = false;
+    return find(data) != size_;
+}
+
+const char* structures::ArrayListString::at(std::size_t index) const {
+    return chars(ArrayList<StringEntry>::at(index));
+}
+
+const char* structures::ArrayListString::operator[](std::size_t index) const {
+    return chars(contents[index]);
+}
+
+void structures::ArrayListString::use_index(bool enabled) {
+    indexed_ = enabled;
+    index_stale_ = true;
+    if (!enabled) {
+        delete[] index_;
+        index_ = nullptr;
+        index_max_size_ = 0;
+    }
+}
+
+// Position of the first entry equal to data, or size_. Slots are only
+// ever added between rebuilds, so a free slot ends the probe.
+std::size_t structures::ArrayListString::probe(const char *data, std::size_t length,
+                                               uint32_t hash) const {
+    std::size_t mask = index_max_size_ - 1;
+    for (std::size_t slot = hash & mask; index_[slot] != 0; slot = (slot + 1) & mask) {
+        if (matches(contents[index_[slot] - 1], data, length, hash)) {
+            return index_[slot] - 1;
+        }
+    }
+    return size_;
+}
+
+// Adds the entry at index unless an equal one, which comes earlier, is
+// already there.
+void structures::ArrayListString::index_entry(std::size_t index) {
+    const StringEntry& entry = contents[index];
+    std::size_t mask = index_max_size_ - 1;
+    std::size_t slot = entry.hash & mask;
+    while (index_[slot] != 0) {
+        if (matches(contents[index_[slot] - 1], chars(entry), entry.length, entry.hash)) {
+            return;
+        }
+        slot = (slot + 1) & mask;
+    }
+    index_[slot] = index + 1;
+}
+
+// The table has at least twice as many slots as the list can hold
+// entries, so it is never more than half full.
+void structures::ArrayListString::rebuild_index() {
+    std::size_t max_size = 16;
+    while (max_size < 2 * max_size_) {
+        max_size *= 2;
+    }
+    if (max_size != index_max_size_) {
+        delete[] index_;
+        index_ = new std::size_t[max_size];
+        index_max_size_ = max_size;
+    }
+    std::memset(index_, 0, index_max_size_ * sizeof(std::size_t));
+    index_stale_ = false;
     for (std::size_t i = 0; i < size_; i++) {
-        if (strcmp(contents[i], data) == 0) {
-            found = true;
-            break;
+        index_entry(i);
+    }
+}
+
+// Bytes held by removed strings, reclaimed by compact().
+std::size_t structures::ArrayListString::garbage() const {
+    return garbage_;
+}
+
+// Rewrites the live long strings back to back in list order, so a scan
+// over the list also walks the arena sequentially.
+void structures::ArrayListString::compact() {
+    char* compacted = new char[arena_max_size_];
+    std::size_t offset = 0;
+    for (std::size_t i = 0; i < size_; i++) {
+        if (contents[i].length < sizeof(contents[i].local)) {
+            continue;
         }
+        std::memcpy(compacted + offset, arena_ + contents[i].offset, contents[i].length + 1);
+        contents[i].offset = offset;
+        offset += contents[i].length + 1;
     }
-    return found;
+    delete[] arena_;
+    arena_ = compacted;
+    arena_size_ = offset;
+    garbage_ = 0;
 }
@@ -0,0 +1,97 @@
+#ifndef BENCH_DATASET_GEN_H
+#define BENCH_DATASET_GEN_H
+
+#include <cstdlib>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+struct DatasetSpec {
+    int images{10};
+    int height{256};
+    int width{256};
+    double density{0.5};    // target fraction of set pixels
+    int blob_min{0};        // blob radii; 0 for independent random pixels
+    int blob_max{0};
+    unsigned seed{42};
+};
+
+// Fills pixels with filled discs whose radius is drawn uniformly from
+// [blob_min, blob_max] until the target density is reached, or with
+// independent random pixels when blob_max is 0.
+void generate_image(const DatasetSpec &spec, std::mt19937 &random, std::vector<char> &pixels) {
+    int height = spec.height;
+    int width = spec.width;
+    pixels.assign(std::size_t(height) * width, '0');
+
+    if (spec.blob_max <= 0) {
+        std::bernoulli_distribution pixel(spec.density);
+        for (std::size_t k = 0; k < pixels.size(); k++) {
+            pixels[k] = pixel(random) ? '1' : '0';
+        }
+        return;
+    }
+
+    std::uniform_int_distribution<int> radius(spec.blob_min, spec.blob_max);
+    std::uniform_int_distribution<int> row(0, height - 1);
+    std::uniform_int_distribution<int> column(0, width - 1);
+    std::size_t target = std::size_t(spec.density * pixels.size());
+    std::size_t set = 0;
+    std::size_t attempts = 0;
+
+    while (set < target && attempts++ < 16 * pixels.size()) {
+        int r = radius(random);
+        int ci = row(random);
+        int cj = column(random);
+        for (int i = ci - r; i <= ci + r; i++) {
+            for (int j = cj - r; j <= cj + r; j++) {
+                if (i < 0 || i >= height || j < 0 || j >= width) continue;
+                if ((i - ci) * (i - ci) + (j - cj) * (j - cj) > r * r) continue;
+                char &p = pixels[std::size_t(i) * width + j];
+                if (p == '0') {
+                    p = '1';
+                    set++;
+                }
+            }
+        }
+    }
+}
+
+// Writes a dataset in the same layout as datasets/dataset01.xml.
+void generate_dataset(const std::string &path, const DatasetSpec &spec) {
+    std::ofstream out(path);
+    std::mt19937 random(spec.seed);
+    std::vector<char> pixels;
+
+    out << "<dataset>\n";
+    for (int n = 0; n < spec.images; n++) {
+        generate_image(spec, random, pixels);
+        out << "<img>\n<name>" << n << ".png</name>\n";
+        out << "<dimensions><height>" << spec.height << "</height><width>"
+            << spec.width << "</width></dimensions>\n<data>\n";
+        for (int i = 0; i < spec.height; i++) {
+            out.write(&pixels[std::size_t(i) * spec.width], spec.width);
+            out << '\n';
+        }
+        out << "</data>\n</img>\n";
+    }
+    out << "</dataset>\n";
+}
+
+void generate_dataset(const std::string &path, int images, int height,
+                      int width, double density, unsigned seed) {
+    DatasetSpec spec;
+    spec.images = images;
+    spec.height = height;
+    spec.width = width;
+    spec.density = density;
+    spec.seed = seed;
+    generate_dataset(path, spec);
+}
+
+}  // namespace bench
+
+#endif
@@ -0,0 +1,56 @@
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "dataset_gen.hpp"
+
+using namespace std;
+
+int usage(const char* program) {
+    cerr << "usage: " << program << " output.xml [--images N] [--height H]"
+         << " [--width W] [--density D] [--blobs MIN MAX] [--seed S]\n";
+    return 1;
+}
+
+// Sizes must be positive, the density a fraction and the blob radii an
+// ordered, non-negative range.
+bool valid(const bench::DatasetSpec &spec) {
+    return spec.images >= 0 && spec.height > 0 && spec.width > 0
+        && spec.density >= 0 && spec.density <= 1
+        && spec.blob_min >= 0 && spec.blob_min <= spec.blob_max;
+}
+
+// Usage: generate_dataset.out output.xml [--images N] [--height H]
+//        [--width W] [--density D] [--blobs MIN MAX] [--seed S]
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        return usage(argv[0]);
+    }
+    bench::DatasetSpec spec;
+    for (int i = 2; i < argc; i++) {
+        string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--images" && has_value) {
+            spec.images = atoi(argv[++i]);
+        } else if (arg == "--height" && has_value) {
+            spec.height = atoi(argv[++i]);
+        } else if (arg == "--width" && has_value) {
+            spec.width = atoi(argv[++i]);
+        } else if (arg == "--density" && has_value) {
+            spec.density = atof(argv[++i]);
+        } else if (arg == "--blobs" && i + 2 < argc) {
+            spec.blob_min = atoi(argv[++i]);
+            spec.blob_max = atoi(argv[++i]);
+        } else if (arg == "--seed" && has_value) {
+            spec.seed = atoi(argv[++i]);
+        } else {
+            cerr << "unknown option " << arg << "\n";
+            return usage(argv[0]);
+        }
+    }
+    if (!valid(spec)) {
+        return usage(argv[0]);
+    }
+    bench::generate_dataset(argv[1], spec);
+    return 0;
+}
@@ -0,0 +1,80 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+
+#include "../include/linked_queue.hpp"
+#include "../include/linked_stack.hpp"
+
+using namespace std;
+
+struct Point {
+    int x;
+    int y;
+};
+
+template<typename F>
+double seconds(F f) {
+    auto begin = chrono::steady_clock::now();
+    f();
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - begin;
+    return elapsed.count();
+}
+
+// Pushes depth elements and pops them all again, rounds times, the
+// pattern of a flood fill sweep.
+template<typename Stack>
+double stack_cycles(int rounds, int depth) {
+    Stack stack;
+    long sink = 0;
+    double s = seconds([&] {
+        for (int r = 0; r < rounds; r++) {
+            for (int i = 0; i < depth; i++) {
+                Point p = {i, r};
+                stack.push(p);
+            }
+            while (!stack.empty()) {
+                sink += stack.pop().x;
+            }
+        }
+    });
+    return sink < 0 ? 0 : s;
+}
+
+template<typename Queue>
+double queue_cycles(int rounds, int depth) {
+    Queue queue;
+    long sink = 0;
+    double s = seconds([&] {
+        for (int r = 0; r < rounds; r++) {
+            for (int i = 0; i < depth; i++) {
+                Point p = {i, r};
+                queue.enqueue(p);
+            }
+            while (!queue.empty()) {
+                sink += queue.dequeue().x;
+            }
+        }
+    });
+    return sink < 0 ? 0 : s;
+}
+
+void report(const char* label, double secs, double operations) {
+    printf("%-28s %9.3f ms %8.1f Mops/s\n", label, secs * 1e3, operations / secs / 1e6);
+}
+
+int main(int argc, char* argv[]) {
+    int rounds = argc > 1 ? atoi(argv[1]) : 200;
+    int depth = argc > 2 ? atoi(argv[2]) : 50000;
+    double operations = 2.0 * rounds * depth;
+
+    report("LinkedStack std::allocator",
+           stack_cycles<structures::LinkedStack<Point, allocator<Point> > >(rounds, depth), operations);
+    report("LinkedStack pooled",
+           stack_cycles<structures::LinkedStack<Point> >(rounds, depth), operations);
+    report("LinkedQueue std::allocator",
+           queue_cycles<structures::LinkedQueue<Point, allocator<Point> > >(rounds, depth), operations);
+    report("LinkedQueue pooled",
+           queue_cycles<structures::LinkedQueue<Point> >(rounds, depth), operations);
+    return 0;
+}
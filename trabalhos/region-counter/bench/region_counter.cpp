@@ -0,0 +1,118 @@
+#include <sys/resource.h>
+
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <string>
+
+#include "../include/dataset_reader.hpp"
+#include "../include/image_loader.hpp"
+#include "../include/region_counter.hpp"
+#include "../include/xml_tools.hpp"
+#include "dataset_gen.hpp"
+
+using namespace std;
+
+class Stopwatch {
+ public:
+    double lap() {
+        chrono::steady_clock::time_point now = chrono::steady_clock::now();
+        chrono::duration<double> elapsed = now - last_;
+        last_ = now;
+        return elapsed.count();
+    }
+
+ private:
+    chrono::steady_clock::time_point last_{chrono::steady_clock::now()};
+};
+
+long peak_rss_kb() {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+// Runs the whole pipeline over one dataset and reports each stage.
+// image::decode replaced the old split + create_matrix pair, so the
+// "load" stage covers both.
+void run(const string &label, const string &path) {
+    Stopwatch watch;
+    string xml = XML::read(path.c_str());
+    double read_s = watch.lap();
+
+    structures::LinkedQueue<string> images = XML::get_tag_all(xml, "img");
+    double tags_s = watch.lap();
+
+    image::Loader loader;
+    image::RegionCounter<image::FOUR> counter;
+    double load_s = 0;
+    double count_s = 0;
+    double pixels = 0;
+    long regions = 0;
+    while (!images.empty()) {
+        string img = images.dequeue();
+        watch.lap();
+        image::Bitmap &matrix = loader.load(img);
+        load_s += watch.lap();
+        pixels += double(matrix.rows()) * matrix.columns();
+        regions += counter.count(matrix);
+        count_s += watch.lap();
+    }
+
+    // The fused reader used by main: raw load plus one validating pass
+    // that yields the image records.
+    string raw;
+    watch.lap();
+    XML::load(path.c_str(), raw);
+    double load_raw_s = watch.lap();
+    XML::DatasetReader reader(raw.data(), raw.size());
+    XML::ImageRecord record;
+    while (reader.next(record)) {}
+    double fused_s = watch.lap();
+
+    double bytes = xml.size();
+    printf("%s: %.1f MB, %.0f pixels, %ld regions\n", label.c_str(), bytes / 1e6, pixels, regions);
+    printf("  %-12s %9.3f ms %10.1f MB/s\n", "read", read_s * 1e3, bytes / read_s / 1e6);
+    printf("  %-12s %9.3f ms %10.1f MB/s\n", "get_tag_all", tags_s * 1e3, bytes / tags_s / 1e6);
+    printf("  %-12s %9.3f ms %10.1f MB/s\n", "raw load", load_raw_s * 1e3, bytes / load_raw_s / 1e6);
+    printf("  %-12s %9.3f ms %10.1f MB/s\n", "fused read", fused_s * 1e3, bytes / fused_s / 1e6);
+    printf("  %-12s %9.3f ms %10.1f Mpixels/s\n", "load", load_s * 1e3, pixels / load_s / 1e6);
+    printf("  %-12s %9.3f ms %10.1f Mpixels/s\n", "count", count_s * 1e3, pixels / count_s / 1e6);
+    printf("  peak RSS %ld kB\n", peak_rss_kb());
+}
+
+// Usage: bench_region_counter.out [dataset.xml ...]
+// Without arguments a few synthetic datasets are generated and measured.
+int main(int argc, char* argv[]) {
+    if (argc > 1) {
+        for (int i = 1; i < argc; i++) {
+            run(argv[i], argv[i]);
+        }
+        return 0;
+    }
+
+    string path = "/tmp/region_counter_bench.xml";
+    bench::DatasetSpec spec;
+    spec.images = 100;
+    spec.height = 512;
+    spec.width = 512;
+
+    spec.density = 0.5;
+    bench::generate_dataset(path, spec);
+    run("noise 50%", path);
+
+    spec.density = 0.3;
+    spec.blob_min = 2;
+    spec.blob_max = 10;
+    bench::generate_dataset(path, spec);
+    run("small blobs 30%", path);
+
+    spec.density = 0.6;
+    spec.blob_min = 20;
+    spec.blob_max = 80;
+    bench::generate_dataset(path, spec);
+    run("large blobs 60%", path);
+
+    remove(path.c_str());
+    return 0;
+}
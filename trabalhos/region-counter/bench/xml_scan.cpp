@@ -0,0 +1,112 @@
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <string>
+
+#include "../include/xml_tools.hpp"
+#include "dataset_gen.hpp"
+
+using namespace std;
+
+// The std::string::find based implementation XML::read and XML::get_tag
+// used before the tag scanner, kept here as the baseline.
+namespace legacy {
+
+string read(const char* path) {
+    string output;
+    structures::LinkedStack<string> tag_stack;
+    ifstream file(path);
+
+    if (file.is_open()) {
+        string line;
+        while (getline(file, line)) {
+            int opener = line.find('<');
+            while (opener != -1) {
+                int closer = line.find('>', opener);
+                if (line[opener + 1] == '/') {
+                    string last_tag = tag_stack.pop();
+                    if (line.substr(opener + 2, last_tag.size()) != last_tag) {
+                        throw out_of_range("Bad XML format");
+                    }
+                } else {
+                    string tag = line.substr(opener + 1, closer - opener - 1);
+                    tag_stack.push(tag);
+                }
+                opener = line.find('<', closer);
+            }
+            output += line + ' ';
+        }
+        file.close();
+    } else {
+        throw out_of_range("Unable to open file");
+    }
+    if (tag_stack.size() != 0) {
+        throw out_of_range("Bad XML format");
+    }
+    return output;
+}
+
+string get_tag(const string &xml_string, string tag, int start) {
+    int opener = xml_string.find('<' + tag + '>', start);
+    int closer = xml_string.find("</" + tag + '>', opener);
+    int opener_end = opener + tag.size() + 2;
+    return xml_string.substr(opener_end, closer - opener_end);
+}
+
+structures::LinkedQueue<string> get_tag_all(const string &xml_string, string tag) {
+    structures::LinkedQueue<string> output;
+
+    string last;
+    int start = 0;
+    bool remain = true;
+    while (remain) {
+        last = get_tag(xml_string, tag, start);
+        output.enqueue(last);
+        start += last.size();
+        remain = (int)xml_string.find('<' + tag + '>', start) != -1;
+    }
+    return output;
+}
+
+}  // namespace legacy
+
+template<typename F>
+double seconds(F f, int repeat) {
+    auto begin = chrono::steady_clock::now();
+    for (int i = 0; i < repeat; i++) {
+        f();
+    }
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - begin;
+    return elapsed.count() / repeat;
+}
+
+void report(const char* label, double bytes, double secs) {
+    printf("%-24s %10.3f ms %10.1f MB/s\n", label, secs * 1e3, bytes / secs / 1e6);
+}
+
+int main(int argc, char* argv[]) {
+    int images = argc > 1 ? atoi(argv[1]) : 200;
+    int side = argc > 2 ? atoi(argv[2]) : 256;
+    int repeat = argc > 3 ? atoi(argv[3]) : 5;
+    string path = "/tmp/region_counter_xml_scan.xml";
+
+    bench::generate_dataset(path, images, side, side, 0.5, 42);
+    string xml = XML::read(path.c_str());
+    double bytes = xml.size();
+    printf("%d images of %dx%d, %.1f MB\n", images, side, side, bytes / 1e6);
+
+    report("legacy read", bytes, seconds([&] { legacy::read(path.c_str()); }, repeat));
+    report("scanner read", bytes, seconds([&] { XML::read(path.c_str()); }, repeat));
+    report("scanner validate", bytes, seconds([&] { XML::validate(xml); }, repeat));
+
+    volatile int sink = 0;
+    report("legacy get_tag_all", bytes, seconds([&] {
+        sink = legacy::get_tag_all(xml, "img").size();
+    }, repeat));
+    report("find_tag get_tag_all", bytes, seconds([&] {
+        sink = XML::get_tag_all(xml, "img").size();
+    }, repeat));
+
+    remove(path.c_str());
+    return sink < 0;
+}
@@ -0,0 +1,113 @@
+#ifndef STRUCTURES_ARRAY_STACK_H
+#define STRUCTURES_ARRAY_STACK_H
+
+#include <cstddef>
+#include <stdexcept>
+
+namespace structures {
+
+// Contiguous stack that doubles its capacity when full. clear() keeps the
+// storage, so a stack reused across calls stops allocating once it has
+// reached its high-water mark.
+template<typename T>
+class ArrayStack {
+ public:
+    ArrayStack();
+    explicit ArrayStack(std::size_t capacity);
+    ~ArrayStack();
+    void clear();
+    void push(const T& data);
+    T pop();
+    T& top() const;
+    bool empty() const;
+    std::size_t size() const;
+    std::size_t capacity() const;
+
+ private:
+    ArrayStack(const ArrayStack&);
+    ArrayStack& operator=(const ArrayStack&);
+
+    void grow();
+
+    T* contents_{nullptr};
+    std::size_t size_{0u};
+    std::size_t capacity_{0u};
+
+    static const std::size_t DEFAULT_CAPACITY = 64u;
+};
+
+
+template<typename T>
+ArrayStack<T>::ArrayStack():
+    ArrayStack(DEFAULT_CAPACITY)
+{}
+
+template<typename T>
+ArrayStack<T>::ArrayStack(std::size_t capacity):
+    contents_{new T[capacity > 0 ? capacity : 1]},
+    capacity_{capacity > 0 ? capacity : 1}
+{}
+
+template<typename T>
+ArrayStack<T>::~ArrayStack() {
+    delete[] contents_;
+}
+
+template<typename T>
+void ArrayStack<T>::clear() {
+    size_ = 0;
+}
+
+template<typename T>
+void ArrayStack<T>::grow() {
+    T* contents = new T[capacity_ * 2];
+    for (std::size_t i = 0; i < size_; i++) {
+        contents[i] = contents_[i];
+    }
+    delete[] contents_;
+    contents_ = contents;
+    capacity_ *= 2;
+}
+
+template<typename T>
+void ArrayStack<T>::push(const T& data) {
+    if (size_ == capacity_) {
+        grow();
+    }
+    contents_[size_++] = data;
+}
+
+template<typename T>
+T ArrayStack<T>::pop() {
+    if (size_ == 0) {
+        throw std::out_of_range("the stack is empty");
+    }
+    return contents_[--size_];
+}
+
+template<typename T>
+T& ArrayStack<T>::top() const {
+    if (size_ == 0) {
+        throw std::out_of_range("the stack is empty");
+    }
+    return contents_[size_ - 1];
+}
+
+template<typename T>
+bool ArrayStack<T>::empty() const {
+    return size_ == 0;
+}
+
+template<typename T>
+std::size_t ArrayStack<T>::size() const {
+    return size_;
+}
+
+template<typename T>
+std::size_t ArrayStack<T>::capacity() const {
+    return capacity_;
+}
+
+}  // namespace structures
+
+#endif
@@ -0,0 +1,263 @@
+#ifndef IMAGE_BITMAP_H
+#define IMAGE_BITMAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace image {
+
+// Binary image packed one bit per pixel, each row padded to whole 64 bit
+// words. Padding bits are always zero.
+class Bitmap {
+ public:
+    Bitmap() {}
+    ~Bitmap() {
+        delete[] bits_;
+    }
+
+    void reset(int rows, int columns) {
+        if (rows < 0 || columns < 0) {
+            throw std::out_of_range("invalid dimensions");
+        }
+        rows_ = rows;
+        columns_ = columns;
+        words_per_row_ = (std::size_t(columns) + 63) / 64;
+        std::size_t words = words_per_row_ * rows_;
+        if (words > capacity_) {
+            delete[] bits_;
+            bits_ = new uint64_t[words];
+            capacity_ = words;
+        }
+        std::memset(bits_, 0, words * sizeof(uint64_t));
+    }
+
+    // Copies other into this bitmap, reusing the current storage if it fits.
+    void assign(const Bitmap &other) {
+        reset(other.rows_, other.columns_);
+        std::memcpy(bits_, other.bits_, words_per_row_ * rows_ * sizeof(uint64_t));
+    }
+
+    int rows() const {
+        return rows_;
+    }
+
+    int columns() const {
+        return columns_;
+    }
+
+    std::size_t words_per_row() const {
+        return words_per_row_;
+    }
+
+    uint64_t* row(int i) {
+        return bits_ + i * words_per_row_;
+    }
+
+    const uint64_t* row(int i) const {
+        return bits_ + i * words_per_row_;
+    }
+
+    bool get(int i, int j) const {
+        return (row(i)[j >> 6] >> (j & 63)) & 1;
+    }
+
+    void set(int i, int j) {
+        row(i)[j >> 6] |= uint64_t(1) << (j & 63);
+    }
+
+    void clear(int i, int j) {
+        row(i)[j >> 6] &= ~(uint64_t(1) << (j & 63));
+    }
+
+    // First set pixel of row i in [from, to), or to if there is none.
+    int next_set(int i, int from, int to) const {
+        const uint64_t* r = row(i);
+        std::size_t w = from >> 6;
+        std::size_t last = (std::size_t(to) + 63) >> 6;
+        if (w >= last) {
+            return to;
+        }
+        uint64_t word = r[w] & (~uint64_t(0) << (from & 63));
+        while (word == 0) {
+            if (++w >= last) {
+                return to;
+            }
+            word = r[w];
+        }
+        int found = int(w * 64) + __builtin_ctzll(word);
+        return found < to ? found : to;
+    }
+
+    // One past the last pixel of the run of set pixels starting at (i, j).
+    int run_end(int i, int j) const {
+        const uint64_t* r = row(i);
+        std::size_t w = j >> 6;
+        uint64_t word = ~r[w] & (~uint64_t(0) << (j & 63));
+        while (word == 0) {
+            if (++w == words_per_row_) {
+                return columns_;
+            }
+            word = ~r[w];
+        }
+        int found = int(w * 64) + __builtin_ctzll(word);
+        return found < columns_ ? found : columns_;
+    }
+
+    // First pixel of the run of set pixels that ends at (i, j).
+    int run_begin(int i, int j) const {
+        const uint64_t* r = row(i);
+        std::size_t w = j >> 6;
+        uint64_t word = ~r[w] & ((uint64_t(1) << (j & 63)) - 1);
+        while (word == 0) {
+            if (w == 0) {
+                return 0;
+            }
+            word = ~r[--w];
+        }
+        return int(w * 64) + 64 - __builtin_clzll(word);
+    }
+
+    // Number of set pixels of row i in [from, to).
+    int count(int i, int from, int to) const {
+        const uint64_t* r = row(i);
+        std::size_t first = from >> 6;
+        std::size_t last = (to - 1) >> 6;
+        uint64_t head = ~uint64_t(0) << (from & 63);
+        uint64_t tail = ~uint64_t(0) >> (63 - ((to - 1) & 63));
+        if (first == last) {
+            return __builtin_popcountll(r[first] & head & tail);
+        }
+        int total = __builtin_popcountll(r[first] & head);
+        for (std::size_t w = first + 1; w < last; w++) {
+            total += __builtin_popcountll(r[w]);
+        }
+        return total + __builtin_popcountll(r[last] & tail);
+    }
+
+    // Clears the pixels of row i in [from, to).
+    void clear_span(int i, int from, int to) {
+        uint64_t* r = row(i);
+        std::size_t first = from >> 6;
+        std::size_t last = (to - 1) >> 6;
+        uint64_t head = ~uint64_t(0) << (from & 63);
+        uint64_t tail = ~uint64_t(0) >> (63 - ((to - 1) & 63));
+        if (first == last) {
+            r[first] &= ~(head & tail);
+            return;
+        }
+        r[first] &= ~head;
+        for (std::size_t w = first + 1; w < last; w++) {
+            r[w] = 0;
+        }
+        r[last] &= ~tail;
+    }
+
+ private:
+    Bitmap(const Bitmap&);
+    Bitmap& operator=(const Bitmap&);
+
+    uint64_t* bits_{nullptr};
+    std::size_t capacity_{0u};
+    std::size_t words_per_row_{0u};
+    int rows_{0};
+    int columns_{0};
+};
+
+// Packs the n <= 64 bytes at p into word, bit i set when p[i] == '1'.
+// Returns false if any of them is not '0' or '1'.
+inline bool pack_tail(const char* p, std::size_t n, uint64_t& word) {
+    bool valid = true;
+    word = 0;
+    for (std::size_t i = 0; i < n; i++) {
+        word |= uint64_t(p[i] == '1') << i;
+        valid &= (p[i] == '0') | (p[i] == '1');
+    }
+    return valid;
+}
+
+// Same as pack_tail for the 64 bytes at p.
+inline bool pack_block(const char* p, uint64_t& word) {
+#if defined(__AVX2__)
+    const __m256i zero = _mm256_set1_epi8('0');
+    const __m256i one = _mm256_set1_epi8('1');
+    __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 32));
+    __m256i lo_one = _mm256_cmpeq_epi8(lo, one);
+    __m256i hi_one = _mm256_cmpeq_epi8(hi, one);
+    __m256i lo_bit = _mm256_or_si256(lo_one, _mm256_cmpeq_epi8(lo, zero));
+    __m256i hi_bit = _mm256_or_si256(hi_one, _mm256_cmpeq_epi8(hi, zero));
+    word = uint32_t(_mm256_movemask_epi8(lo_one))
+        | uint64_t(uint32_t(_mm256_movemask_epi8(hi_one))) << 32;
+    return (_mm256_movemask_epi8(_mm256_and_si256(lo_bit, hi_bit))) == -1;
+#elif defined(__SSE2__)
+    const __m128i zero = _mm_set1_epi8('0');
+    const __m128i one = _mm_set1_epi8('1');
+    __m128i valid = _mm_set1_epi8(-1);
+    word = 0;
+    for (int i = 0; i < 4; i++) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16 * i));
+        __m128i is_one = _mm_cmpeq_epi8(chunk, one);
+        valid = _mm_and_si128(valid, _mm_or_si128(is_one, _mm_cmpeq_epi8(chunk, zero)));
+        word |= uint64_t(uint16_t(_mm_movemask_epi8(is_one))) << (16 * i);
+    }
+    return _mm_movemask_epi8(valid) == 0xffff;
+#else
+    return pack_tail(p, 64, word);
+#endif
+}
+
+inline bool is_space(char c) {
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+}
+
+// Decodes the text of a <data> tag (rows of '0'/'1' separated by
+// whitespace) straight into output, which is resized to height x width.
+// Throws if the text does not hold exactly height rows of width pixels,
+// before allocating anything for dimensions the text cannot fill.
+void decode(const char* text, std::size_t size, int height, int width, Bitmap& output) {
+    if (uint64_t(height) * uint64_t(width) > size) {
+        throw std::out_of_range("Bad image data");
+    }
+    output.reset(height, width);
+    const char* p = text;
+    const char* end = text + size;
+
+    for (int i = 0; i < height; i++) {
+        while (p < end && is_space(*p)) {
+            p++;
+        }
+        if (end - p < width) {
+            throw std::out_of_range("Bad image data");
+        }
+        uint64_t* row = output.row(i);
+        bool valid = true;
+        int j = 0;
+        for (; j + 64 <= width; j += 64) {
+            valid &= pack_block(p + j, *row++);
+        }
+        if (j < width) {
+            valid &= pack_tail(p + j, width - j, *row);
+        }
+        p += width;
+        if (!valid || (p < end && !is_space(*p))) {
+            throw std::out_of_range("Bad image data");
+        }
+    }
+    while (p < end) {
+        if (!is_space(*p++)) {
+            throw std::out_of_range("Bad image data");
+        }
+    }
+}
+
+}  // namespace image
+
+#endif
@@ -0,0 +1,158 @@
+#ifndef XML_DATASET_READER_H
+#define XML_DATASET_READER_H
+
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+
+#include "profile.hpp"
+#include "tag_scanner.hpp"
+
+namespace XML {
+
+// Where the fields of one <img> live in the dataset text.
+struct ImageRecord {
+    std::size_t name_begin;
+    std::size_t name_end;
+    std::size_t data_begin;
+    std::size_t data_end;
+    int height;
+    int width;
+};
+
+// Validates tag nesting under a single <dataset> root and extracts <img>
+// records in a single pass over the raw dataset text. Tag names are
+// interned to small integers that point back into the text, and nesting
+// is checked on a fixed size integer stack, so reading a dataset does not
+// allocate.
+class DatasetReader {
+ public:
+    DatasetReader(const char* data, std::size_t size):
+        data_{data},
+        scanner_(data, size)
+    {
+        intern("img", 3);
+        intern("name", 4);
+        intern("height", 6);
+        intern("width", 5);
+        intern("data", 4);
+        intern("dataset", 7);
+    }
+
+    // Moves to the next <img>, returning false once the whole text has
+    // been read. Throws on bad nesting, even after earlier records.
+    bool next(ImageRecord &record) {
+        PROFILE_SCOPE(PARSE);
+        std::size_t start = scanner_.position();
+        TagScanner::Tag tag;
+        while (scanner_.next(tag)) {
+            if (!tag.closing) {
+                if (depth_ == MAX_DEPTH) {
+                    throw std::out_of_range("Bad XML format");
+                }
+                ids_[depth_] = intern(data_ + tag.begin + 1, tag.end - tag.begin - 1);
+                if (depth_ == 0 && (ids_[0] != DATASET || seen_root_)) {
+                    throw std::out_of_range("Bad XML format");
+                }
+                seen_root_ = true;
+                contents_[depth_] = tag.end + 1;
+                depth_++;
+                if (ids_[depth_ - 1] == IMG) {
+                    fields_ = 0;
+                }
+                continue;
+            }
+
+            int id = find(data_ + tag.begin + 2, tag.end - tag.begin - 2);
+            if (depth_ == 0 || id != ids_[depth_ - 1]) {
+                throw std::out_of_range("Bad XML format");
+            }
+            depth_--;
+            std::size_t begin = contents_[depth_];
+            std::size_t end = tag.begin;
+
+            if (id == NAME) {
+                record.name_begin = begin;
+                record.name_end = end;
+                fields_ |= 1 << NAME;
+            } else if (id == HEIGHT) {
+                record.height = dimension(begin, end);
+                fields_ |= 1 << HEIGHT;
+            } else if (id == WIDTH) {
+                record.width = dimension(begin, end);
+                fields_ |= 1 << WIDTH;
+            } else if (id == DATA) {
+                record.data_begin = begin;
+                record.data_end = end;
+                fields_ |= 1 << DATA;
+            } else if (id == IMG) {
+                if (fields_ != ALL_FIELDS) {
+                    throw std::out_of_range("Incomplete image");
+                }
+                PROFILE_BYTES(PARSE, scanner_.position() - start);
+                return true;
+            }
+        }
+        if (depth_ != 0 || !seen_root_) {
+            throw std::out_of_range("Bad XML format");
+        }
+        PROFILE_BYTES(PARSE, scanner_.position() - start);
+        return false;
+    }
+
+ private:
+    enum { IMG, NAME, HEIGHT, WIDTH, DATA, DATASET };
+
+    static const int ALL_FIELDS = 1 << NAME | 1 << HEIGHT | 1 << WIDTH | 1 << DATA;
+    static const int MAX_DEPTH = 256;
+    static const int MAX_TAGS = 256;
+
+    int find(const char* name, std::size_t size) const {
+        for (int id = 0; id < tags_; id++) {
+            if (sizes_[id] == size && std::memcmp(names_[id], name, size) == 0) {
+                return id;
+            }
+        }
+        return -1;
+    }
+
+    int intern(const char* name, std::size_t size) {
+        int id = find(name, size);
+        if (id != -1) {
+            return id;
+        }
+        if (tags_ == MAX_TAGS) {
+            throw std::out_of_range("Too many distinct tags");
+        }
+        names_[tags_] = name;
+        sizes_[tags_] = size;
+        return tags_++;
+    }
+
+    int dimension(std::size_t begin, std::size_t end) const {
+        char* parsed;
+        long value = std::strtol(data_ + begin, &parsed, 10);
+        if (parsed == data_ + begin || parsed > data_ + end || value < 0 || value > 1 << 30) {
+            throw std::out_of_range("Bad image dimensions");
+        }
+        return int(value);
+    }
+
+    const char* data_;
+    TagScanner scanner_;
+
+    int ids_[MAX_DEPTH];
+    std::size_t contents_[MAX_DEPTH];
+    int depth_{0};
+
+    const char* names_[MAX_TAGS];
+    std::size_t sizes_[MAX_TAGS];
+    int tags_{0};
+
+    int fields_{0};
+    bool seen_root_{false};
+};
+
+}  // namespace XML
+
+#endif
@@ -0,0 +1,84 @@
+#ifndef IMAGE_LOADER_H
+#define IMAGE_LOADER_H
+
+#include <cstdlib>
+#include <string>
+
+#include "bitmap.hpp"
+#include "dataset_reader.hpp"
+#include "packed_dataset.hpp"
+#include "profile.hpp"
+#include "xml_tools.hpp"
+
+namespace image {
+
+// Loads <img> records into a single bitmap that is reused from one image
+// to the next, sized from the <height> and <width> tags of each record.
+class Loader {
+ public:
+    Bitmap& load(const std::string &img) {
+        PROFILE_SCOPE(DECODE);
+        std::size_t begin, end, next;
+        if (!XML::find_tag(img, "name", 0, begin, end, next)) {
+            throw std::out_of_range("Missing image name");
+        }
+        name_.assign(img, begin, end - begin);
+
+        int height = dimension(img, "height");
+        int width = dimension(img, "width");
+
+        if (!XML::find_tag(img, "data", 0, begin, end, next)) {
+            throw std::out_of_range("Missing image data");
+        }
+        decode(img.data() + begin, end - begin, height, width, bitmap_);
+        PROFILE_BYTES(DECODE, end - begin);
+        return bitmap_;
+    }
+
+    // Loads a record found by XML::DatasetReader in the text at xml.
+    Bitmap& load(const char* xml, const XML::ImageRecord &record) {
+        PROFILE_SCOPE(DECODE);
+        PROFILE_BYTES(DECODE, record.data_end - record.data_begin);
+        name_.assign(xml + record.name_begin, record.name_end - record.name_begin);
+        decode(xml + record.data_begin, record.data_end - record.data_begin,
+               record.height, record.width, bitmap_);
+        return bitmap_;
+    }
+
+    Bitmap& load(const PackedDataset &dataset, std::size_t i) {
+        PROFILE_SCOPE(DECODE);
+#ifdef REGION_COUNTER_PROFILE
+        std::size_t bytes;
+        dataset.pixels(i, bytes);
+        PROFILE_BYTES(DECODE, bytes);
+#endif
+        dataset.name(i, name_);
+        dataset.load(i, bitmap_);
+        return bitmap_;
+    }
+
+    const std::string& name() const {
+        return name_;
+    }
+
+ private:
+    static int dimension(const std::string &img, const std::string &tag) {
+        std::size_t begin, end, next;
+        if (!XML::find_tag(img, tag, 0, begin, end, next)) {
+            throw std::out_of_range("Missing image dimensions");
+        }
+        char* parsed;
+        long value = std::strtol(img.c_str() + begin, &parsed, 10);
+        if (parsed == img.c_str() + begin || value < 0 || value > 1 << 30) {
+            throw std::out_of_range("Bad image dimensions");
+        }
+        return int(value);
+    }
+
+    Bitmap bitmap_;
+    std::string name_;
+};
+
+}  // namespace image
+
+#endif
@@ -1,10 +1,20 @@
 #ifndef STRUCTURES_LINKED_QUEUE_H
 #define STRUCTURES_LINKED_QUEUE_H
 
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+
+#include "node_pool.hpp"
+
 namespace structures {
 
 
-template<typename T>
+// Nodes come from Allocator, by default a per-thread pool, so steady-state
+// enqueue/dequeue cycles do not reach the global allocator.
+template<typename T, typename Allocator = PoolAllocator<T> >
 class LinkedQueue {
  public:
     LinkedQueue();
@@ -64,27 +74,90 @@ class LinkedQueue {
         return it;
     }
 
+    typedef typename std::allocator_traits<Allocator>::template rebind_alloc<Node> NodeAllocator;
+    typedef std::allocator_traits<NodeAllocator> NodeTraits;
+
     Node* head{nullptr};
     Node* tail{nullptr};
     int size_{0u};
+    NodeAllocator allocator_;
+
+    // Walks the queue from front to back without dequeuing, so a scan is
+    // linear instead of an at(i) per element.
+    template<typename NodePointer, typename Reference>
+    class Iterator {
+     public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef T value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef typename std::remove_reference<Reference>::type* pointer;
+        typedef Reference reference;
+
+        Iterator(NodePointer node, std::size_t index):
+            node_{node},
+            index_{index}
+        {}
+
+        Reference operator*() const {
+            return node_->data();
+        }
+
+        pointer operator->() const {
+            return &node_->data();
+        }
+
+        Iterator& operator++() {
+            node_ = node_->next();
+            index_++;
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        bool operator==(const Iterator& other) const {
+            return index_ == other.index_;
+        }
+
+        bool operator!=(const Iterator& other) const {
+            return index_ != other.index_;
+        }
+
+     private:
+        NodePointer node_;
+        std::size_t index_;
+    };
+
+ public:
+    typedef Iterator<Node*, T&> iterator;
+    typedef Iterator<const Node*, const T&> const_iterator;
+
+    iterator begin();
+    iterator end();
+    const_iterator begin() const;
+    const_iterator end() const;
 };
 
 
 
-template<typename T>
-LinkedQueue<T>::LinkedQueue() {}
+template<typename T, typename Allocator>
+LinkedQueue<T, Allocator>::LinkedQueue() {}
 
-template<typename T>
-LinkedQueue<T>::~LinkedQueue() {
+template<typename T, typename Allocator>
+LinkedQueue<T, Allocator>::~LinkedQueue() {
     clear();
 }
 
-template<typename T>
-void LinkedQueue<T>::clear() {
+template<typename T, typename Allocator>
+void LinkedQueue<T, Allocator>::clear() {
     Node* last = head;
     for (int i = 0; i < size_; i++) {
         Node* next = last->next();
-        delete last;
+        NodeTraits::destroy(allocator_, last);
+        NodeTraits::deallocate(allocator_, last, 1);
         last = next;
     }
     head = nullptr;
@@ -92,9 +165,10 @@ void LinkedQueue<T>::clear() {
     size_ = 0;
 }
 
-template<typename T>
-void LinkedQueue<T>::enqueue(const T& data) {
-    Node* new_node = new Node(data);
+template<typename T, typename Allocator>
+void LinkedQueue<T, Allocator>::enqueue(const T& data) {
+    Node* new_node = NodeTraits::allocate(allocator_, 1);
+    NodeTraits::construct(allocator_, new_node, data);
     if (size_ == 0) {
         head = new_node;
     } else {
@@ -104,58 +178,79 @@ void LinkedQueue<T>::enqueue(const T& data) {
     size_++;
 }
 
-template<typename T>
-T LinkedQueue<T>::dequeue() {
+template<typename T, typename Allocator>
+T LinkedQueue<T, Allocator>::dequeue() {
     if (size_ == 0) {
         throw std::out_of_range("the stack is empty");
     }
     Node* popped = head;
     T data = popped->data();
     head = popped->next();
-    delete popped;
+    NodeTraits::destroy(allocator_, popped);
+    NodeTraits::deallocate(allocator_, popped, 1);
     size_--;
     return data;
 }
 
-template<typename T>
-T& LinkedQueue<T>::front() const {
+template<typename T, typename Allocator>
+T& LinkedQueue<T, Allocator>::front() const {
     if (size_ == 0) {
         throw std::out_of_range("the stack is empty");
     }
     return head->data();
 }
 
-template<typename T>
-T& LinkedQueue<T>::back() const {
+template<typename T, typename Allocator>
+T& LinkedQueue<T, Allocator>::back() const {
     if (size_ == 0) {
         throw std::out_of_range("the stack is empty");
     }
     return tail->data();
 }
 
-template<typename T>
-bool LinkedQueue<T>::empty() const {
+template<typename T, typename Allocator>
+bool LinkedQueue<T, Allocator>::empty() const {
     return size_ == 0;
 }
 
-template<typename T>
-int LinkedQueue<T>::size() const {
+template<typename T, typename Allocator>
+int LinkedQueue<T, Allocator>::size() const {
     return size_;
 }
 
-template<typename T>
-T& LinkedQueue<T>::at(int index) const {
+template<typename T, typename Allocator>
+T& LinkedQueue<T, Allocator>::at(int index) const {
     if (index < 0 || index >= size_) {
         throw std::out_of_range("invalid index");
     }
     return node_at(index)->data();
 }
 
-template<typename T>
-T& LinkedQueue<T>::operator[](int index) const {
+template<typename T, typename Allocator>
+T& LinkedQueue<T, Allocator>::operator[](int index) const {
     return at(index);
 }
 
+template<typename T, typename Allocator>
+typename LinkedQueue<T, Allocator>::iterator LinkedQueue<T, Allocator>::begin() {
+    return iterator(head, 0);
+}
+
+template<typename T, typename Allocator>
+typename LinkedQueue<T, Allocator>::iterator LinkedQueue<T, Allocator>::end() {
+    return iterator(nullptr, size_);
+}
+
+template<typename T, typename Allocator>
+typename LinkedQueue<T, Allocator>::const_iterator LinkedQueue<T, Allocator>::begin() const {
+    return const_iterator(head, 0);
+}
+
+template<typename T, typename Allocator>
+typename LinkedQueue<T, Allocator>::const_iterator LinkedQueue<T, Allocator>::end() const {
+    return const_iterator(nullptr, size_);
+}
+
 }  // namespace structures
 
 #endif
\ No newline at end of file
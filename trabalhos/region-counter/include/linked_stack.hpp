@@ -1,12 +1,20 @@
 #ifndef STRUCTURES_LINKED_STACK_H
 #define STRUCTURES_LINKED_STACK_H
 
+#include <cstddef>
 #include <iostream>
+#include <iterator>
+#include <memory>
 #include <stdexcept>
+#include <type_traits>
+
+#include "node_pool.hpp"
 
 namespace structures {
 
-template<typename T>
+// Nodes come from Allocator, by default a per-thread pool, so steady-state
+// push/pop cycles do not reach the global allocator.
+template<typename T, typename Allocator = PoolAllocator<T> >
 class LinkedStack {
  public:
     LinkedStack();
@@ -54,69 +62,153 @@ class LinkedStack {
         Node* next_{nullptr};
     };
 
+    typedef typename std::allocator_traits<Allocator>::template rebind_alloc<Node> NodeAllocator;
+    typedef std::allocator_traits<NodeAllocator> NodeTraits;
+
     Node* top_{nullptr};
     std::size_t size_{0u};
+    NodeAllocator allocator_;
+
+    // Walks the stack from top to bottom.
+    template<typename NodePointer, typename Reference>
+    class Iterator {
+     public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef T value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef typename std::remove_reference<Reference>::type* pointer;
+        typedef Reference reference;
+
+        Iterator(NodePointer node, std::size_t index):
+            node_{node},
+            index_{index}
+        {}
+
+        Reference operator*() const {
+            return node_->data();
+        }
+
+        pointer operator->() const {
+            return &node_->data();
+        }
+
+        Iterator& operator++() {
+            node_ = node_->next();
+            index_++;
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        bool operator==(const Iterator& other) const {
+            return index_ == other.index_;
+        }
+
+        bool operator!=(const Iterator& other) const {
+            return index_ != other.index_;
+        }
+
+     private:
+        NodePointer node_;
+        std::size_t index_;
+    };
+
+ public:
+    typedef Iterator<Node*, T&> iterator;
+    typedef Iterator<const Node*, const T&> const_iterator;
+
+    iterator begin();
+    iterator end();
+    const_iterator begin() const;
+    const_iterator end() const;
 };
 
 
-template<typename T>
-LinkedStack<T>::LinkedStack() {}
+template<typename T, typename Allocator>
+LinkedStack<T, Allocator>::LinkedStack() {}
 
-template<typename T>
-LinkedStack<T>::~LinkedStack() {
+template<typename T, typename Allocator>
+LinkedStack<T, Allocator>::~LinkedStack() {
     clear();
 }
 
-template<typename T>
-void LinkedStack<T>::clear() {
+template<typename T, typename Allocator>
+void LinkedStack<T, Allocator>::clear() {
     Node* last = top_;
     for (std::size_t i = 0; i < size_; i++) {
         Node* next = last->next();
-        delete last;
+        NodeTraits::destroy(allocator_, last);
+        NodeTraits::deallocate(allocator_, last, 1);
         last = next;
     }
     top_ = nullptr;
     size_ = 0;
 }
 
-template<typename T>
-void LinkedStack<T>::push(const T& data) {
-    Node* new_node = new Node(data, top_);
+template<typename T, typename Allocator>
+void LinkedStack<T, Allocator>::push(const T& data) {
+    Node* new_node = NodeTraits::allocate(allocator_, 1);
+    NodeTraits::construct(allocator_, new_node, data, top_);
     top_ = new_node;
     size_++;
 }
 
-template<typename T>
-T LinkedStack<T>::pop() {
+template<typename T, typename Allocator>
+T LinkedStack<T, Allocator>::pop() {
     if (size_ == 0) {
         throw std::out_of_range("the stack is empty");
     }
     Node* popped = top_;
     T data = popped->data();
     top_ = popped->next();
-    delete popped;
+    NodeTraits::destroy(allocator_, popped);
+    NodeTraits::deallocate(allocator_, popped, 1);
     size_--;
     return data;
 }
 
-template<typename T>
-T& LinkedStack<T>::top() const {
+template<typename T, typename Allocator>
+T& LinkedStack<T, Allocator>::top() const {
     if (size_ == 0) {
         throw std::out_of_range("the stack is empty");
     }
     return top_->data();
 }
 
-template<typename T>
-bool LinkedStack<T>::empty() const {
+template<typename T, typename Allocator>
+bool LinkedStack<T, Allocator>::empty() const {
     return size_ == 0;
 }
 
-template<typename T>
-std::size_t LinkedStack<T>::size() const {
+template<typename T, typename Allocator>
+std::size_t LinkedStack<T, Allocator>::size() const {
     return size_;
 }
 
+template<typename T, typename Allocator>
+typename LinkedStack<T, Allocator>::iterator LinkedStack<T, Allocator>::begin() {
+    return iterator(top_, 0);
+}
+
+template<typename T, typename Allocator>
+typename LinkedStack<T, Allocator>::iterator LinkedStack<T, Allocator>::end() {
+    return iterator(nullptr, size_);
+}
+
+template<typename T, typename Allocator>
+typename LinkedStack<T, Allocator>::const_iterator LinkedStack<T, Allocator>::begin() const {
+    return const_iterator(top_, 0);
+}
+
+template<typename T, typename Allocator>
+typename LinkedStack<T, Allocator>::const_iterator LinkedStack<T, Allocator>::end() const {
+    return const_iterator(nullptr, size_);
+}
+
 }  // namespace structures
 
 #endif
\ No newline at end of file
@@ -0,0 +1,77 @@
+#ifndef IO_MAPPED_FILE_H
+#define IO_MAPPED_FILE_H
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstddef>
+#include <stdexcept>
+
+#include "profile.hpp"
+
+namespace io {
+
+// Pipes, FIFOs and devices report no size and cannot be mapped.
+inline bool is_regular(const char* path) {
+    struct stat info;
+    return stat(path, &info) == 0 && S_ISREG(info.st_mode);
+}
+
+// Read-only memory mapping of a whole regular file.
+class MappedFile {
+ public:
+    explicit MappedFile(const char* path) {
+        PROFILE_SCOPE(LOAD);
+        int fd = open(path, O_RDONLY);
+        if (fd == -1) {
+            throw std::out_of_range("Unable to open file");
+        }
+        struct stat info;
+        if (fstat(fd, &info) == -1) {
+            close(fd);
+            throw std::out_of_range("Unable to open file");
+        }
+        if (!S_ISREG(info.st_mode)) {
+            close(fd);
+            throw std::out_of_range("Unable to map file");
+        }
+        size_ = info.st_size;
+        if (size_ > 0) {
+            void* data = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (data == MAP_FAILED) {
+                close(fd);
+                throw std::out_of_range("Unable to map file");
+            }
+            data_ = static_cast<const char*>(data);
+        }
+        close(fd);
+        PROFILE_BYTES(LOAD, size_);
+    }
+
+    ~MappedFile() {
+        if (data_ != nullptr) {
+            munmap(const_cast<char*>(data_), size_);
+        }
+    }
+
+    const char* data() const {
+        return data_;
+    }
+
+    std::size_t size() const {
+        return size_;
+    }
+
+ private:
+    MappedFile(const MappedFile&);
+    MappedFile& operator=(const MappedFile&);
+
+    const char* data_{nullptr};
+    std::size_t size_{0u};
+};
+
+}  // namespace io
+
+#endif
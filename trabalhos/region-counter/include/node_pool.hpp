@@ -0,0 +1,132 @@
+#ifndef STRUCTURES_NODE_POOL_H
+#define STRUCTURES_NODE_POOL_H
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
+namespace structures {
+
+// Per-thread free list of Size byte blocks, carved out of chunks of
+// CHUNK_BLOCKS blocks. Freed blocks go back to the list of the thread
+// that frees them, so nodes must not outlive the thread that allocated
+// them. Chunks are released when the thread exits, unless blocks are
+// still in use (e.g. by containers with static storage), in which case
+// they are left to the operating system.
+template<std::size_t Size, std::size_t Align>
+class NodePool {
+ public:
+    static void* allocate() {
+        State &state = local();
+        if (state.free == nullptr) {
+            refill(state);
+        }
+        Block* block = state.free;
+        state.free = block->next;
+        state.live++;
+        return block;
+    }
+
+    static void deallocate(void* p) {
+        State &state = local();
+        Block* block = static_cast<Block*>(p);
+        block->next = state.free;
+        state.free = block;
+        state.live--;
+    }
+
+ private:
+    static const std::size_t CHUNK_BLOCKS = 256u;
+
+    union Block {
+        Block* next;
+        typename std::aligned_storage<Size, Align>::type storage;
+    };
+
+    struct Chunk {
+        Chunk* next;
+        Block blocks[CHUNK_BLOCKS];
+    };
+
+    // Trivially destructible, so it stays usable after Releaser has run.
+    struct State {
+        Block* free;
+        Chunk* chunks;
+        std::size_t live;
+    };
+
+    struct Releaser {
+        ~Releaser() {
+            State &state = local();
+            if (state.live != 0) {
+                return;
+            }
+            while (state.chunks != nullptr) {
+                Chunk* next = state.chunks->next;
+                ::operator delete(state.chunks);
+                state.chunks = next;
+            }
+            state.free = nullptr;
+        }
+    };
+
+    static State& local() {
+        static thread_local State state;
+        static thread_local Releaser releaser;
+        (void) releaser;
+        return state;
+    }
+
+    static void refill(State &state) {
+        Chunk* chunk = static_cast<Chunk*>(::operator new(sizeof(Chunk)));
+        chunk->next = state.chunks;
+        state.chunks = chunk;
+        for (std::size_t i = 0; i < CHUNK_BLOCKS; i++) {
+            chunk->blocks[i].next = i + 1 < CHUNK_BLOCKS ? &chunk->blocks[i + 1] : state.free;
+        }
+        state.free = &chunk->blocks[0];
+    }
+};
+
+// Allocator that takes single objects from the NodePool of their size,
+// which is how the linked structures allocate their nodes. Larger
+// requests go to the global allocator.
+template<typename T>
+class PoolAllocator {
+ public:
+    typedef T value_type;
+
+    PoolAllocator() {}
+
+    template<typename U>
+    PoolAllocator(const PoolAllocator<U>&) {}
+
+    T* allocate(std::size_t n) {
+        if (n == 1) {
+            return static_cast<T*>(NodePool<sizeof(T), alignof(T)>::allocate());
+        }
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    void deallocate(T* p, std::size_t n) {
+        if (n == 1) {
+            NodePool<sizeof(T), alignof(T)>::deallocate(p);
+        } else {
+            ::operator delete(p);
+        }
+    }
+};
+
+template<typename T, typename U>
+bool operator==(const PoolAllocator<T>&, const PoolAllocator<U>&) {
+    return true;
+}
+
+template<typename T, typename U>
+bool operator!=(const PoolAllocator<T>&, const PoolAllocator<U>&) {
+    return false;
+}
+
+}  // namespace structures
+
+#endif
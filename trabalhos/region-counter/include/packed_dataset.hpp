@@ -0,0 +1,206 @@
+#ifndef IMAGE_PACKED_DATASET_H
+#define IMAGE_PACKED_DATASET_H
+
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+
+#include "bitmap.hpp"
+
+namespace image {
+
+// Binary alternative to the XML datasets, laid out as
+//
+//     header  "RCPACK02", image count (u64), index offset (u64)
+//     image   name size (u32), height (u32), width (u32), name,
+//             (height * width + 7) / 8 bytes of pixels, pixel (i, j) in
+//             bit b % 8 of byte b / 8 for b = i * width + j
+//     index   offset of every image (u64)
+//
+// All integers are little endian. Pixels take one bit each with no row
+// padding, so the pixel data is eight times smaller than the XML text.
+namespace packed {
+
+const char MAGIC[8] = {'R', 'C', 'P', 'A', 'C', 'K', '0', '2'};
+const std::size_t HEADER_SIZE = 24;
+const std::size_t IMAGE_HEADER_SIZE = 12;
+
+inline uint64_t read_u64(const char* p) {
+    uint64_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+inline uint32_t read_u32(const char* p) {
+    uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+inline uint64_t image_bytes(uint64_t height, uint64_t width) {
+    return (height * width + 7) / 8;
+}
+
+// The 64 bits starting at bit position of the size bytes at data; bits
+// past the end read as zero.
+inline uint64_t read_bits(const char* data, std::size_t size, uint64_t position) {
+    std::size_t first = position / 8;
+    unsigned char window[9] = {0};
+    std::memcpy(window, data + first, size - first < 9 ? size - first : 9);
+    uint64_t low;
+    std::memcpy(&low, window, sizeof(low));
+    unsigned shift = position % 8;
+    if (shift == 0) {
+        return low;
+    }
+    return low >> shift | uint64_t(window[8]) << (64 - shift);
+}
+
+}  // namespace packed
+
+class PackedWriter {
+ public:
+    explicit PackedWriter(std::ostream &out):
+        out_(out)
+    {
+        out_.write(packed::MAGIC, sizeof(packed::MAGIC));
+        write_u64(0);
+        write_u64(0);
+        offset_ = packed::HEADER_SIZE;
+    }
+
+    void add(const std::string &name, const Bitmap &image) {
+        offsets_ += std::string(reinterpret_cast<const char*>(&offset_), sizeof(offset_));
+        write_u32(name.size());
+        write_u32(image.rows());
+        write_u32(image.columns());
+        out_.write(name.data(), name.size());
+
+        uint64_t width = image.columns();
+        std::string bits(packed::image_bytes(image.rows(), width), '\0');
+        for (int i = 0; i < image.rows(); i++) {
+            for (int j = image.next_set(i, 0, image.columns()); j < image.columns();
+                 j = image.next_set(i, j + 1, image.columns())) {
+                uint64_t b = i * width + j;
+                bits[b / 8] |= char(1 << (b % 8));
+            }
+        }
+        out_.write(bits.data(), bits.size());
+        offset_ += packed::IMAGE_HEADER_SIZE + name.size() + bits.size();
+    }
+
+    // Appends the index and fills in the header.
+    void finish() {
+        out_.write(offsets_.data(), offsets_.size());
+        out_.seekp(sizeof(packed::MAGIC));
+        write_u64(offsets_.size() / sizeof(uint64_t));
+        write_u64(offset_);
+        out_.flush();
+    }
+
+ private:
+    void write_u64(uint64_t value) {
+        out_.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    void write_u32(uint32_t value) {
+        out_.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    std::ostream &out_;
+    std::string offsets_;
+    uint64_t offset_;
+};
+
+// Random access view of a packed dataset held in memory, usually a
+// mapped file. Nothing is copied until an image is loaded.
+class PackedDataset {
+ public:
+    PackedDataset(const char* data, std::size_t size):
+        data_{data}
+    {
+        if (!is_packed(data, size)) {
+            throw std::out_of_range("Bad packed dataset");
+        }
+        count_ = packed::read_u64(data + sizeof(packed::MAGIC));
+        index_ = packed::read_u64(data + sizeof(packed::MAGIC) + 8);
+        if (index_ > size || count_ > (size - index_) / sizeof(uint64_t)) {
+            throw std::out_of_range("Bad packed dataset");
+        }
+    }
+
+    static bool is_packed(const char* data, std::size_t size) {
+        return size >= packed::HEADER_SIZE
+            && std::memcmp(data, packed::MAGIC, sizeof(packed::MAGIC)) == 0;
+    }
+
+    std::size_t size() const {
+        return count_;
+    }
+
+    void name(std::size_t i, std::string &output) const {
+        const char* image = at(i);
+        output.assign(image + packed::IMAGE_HEADER_SIZE, packed::read_u32(image));
+    }
+
+    // The packed pixels of image i, e.g. for hashing.
+    const char* pixels(std::size_t i, std::size_t &bytes) const {
+        const char* image = at(i);
+        bytes = packed::image_bytes(packed::read_u32(image + 4), packed::read_u32(image + 8));
+        return image + packed::IMAGE_HEADER_SIZE + packed::read_u32(image);
+    }
+
+    // Rows start at any bit, so each word of the bitmap is read from a
+    // shifted window of the pixel bytes.
+    void load(std::size_t i, Bitmap &output) const {
+        const char* image = at(i);
+        int height = packed::read_u32(image + 4);
+        int width = packed::read_u32(image + 8);
+        std::size_t bytes;
+        const char* bits = pixels(i, bytes);
+
+        output.reset(height, width);
+        std::size_t words = output.words_per_row();
+        for (int r = 0; r < height; r++) {
+            uint64_t* row = output.row(r);
+            uint64_t position = uint64_t(r) * width;
+            for (std::size_t k = 0; k < words; k++) {
+                row[k] = packed::read_bits(bits, bytes, position + 64 * k);
+            }
+            if (width % 64 != 0) {
+                row[words - 1] &= ~uint64_t(0) >> (64 - width % 64);
+            }
+        }
+    }
+
+ private:
+    // Checks that the whole of image i lies inside the data.
+    const char* at(std::size_t i) const {
+        if (i >= count_) {
+            throw std::out_of_range("invalid index");
+        }
+        uint64_t offset = packed::read_u64(data_ + index_ + i * sizeof(uint64_t));
+        if (offset > index_ || index_ - offset < packed::IMAGE_HEADER_SIZE) {
+            throw std::out_of_range("Bad packed dataset");
+        }
+        const char* image = data_ + offset;
+        uint64_t height = packed::read_u32(image + 4);
+        uint64_t width = packed::read_u32(image + 8);
+        uint64_t bytes = packed::IMAGE_HEADER_SIZE + packed::read_u32(image)
+            + packed::image_bytes(height, width);
+        if (width > 1 << 30 || height > 1 << 30 || bytes > index_ - offset) {
+            throw std::out_of_range("Bad packed dataset");
+        }
+        return image;
+    }
+
+    const char* data_;
+    uint64_t count_;
+    uint64_t index_;
+};
+
+}  // namespace image
+
+#endif
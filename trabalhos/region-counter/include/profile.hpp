@@ -0,0 +1,142 @@
+#ifndef PROFILE_H
+#define PROFILE_H
+
+// Hot-path instrumentation, compiled in only with -DREGION_COUNTER_PROFILE
+// ("make profile"). Otherwise every macro below expands to nothing.
+//
+// PROFILE_SCOPE(STAGE)          time the rest of the block as STAGE
+// PROFILE_BYTES(STAGE, n)       count n bytes processed by STAGE
+// PROFILE_STACK_DEPTH(n)        track the sweep stack high-water mark
+//
+// A JSON summary is written to stderr at exit.
+
+#ifdef REGION_COUNTER_PROFILE
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <chrono>
+#endif
+
+namespace profile {
+
+enum Stage { READ, GET_TAG_ALL, LOAD, PARSE, DECODE, COUNT, STAGES };
+
+inline uint64_t ticks() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+struct Counters {
+    uint64_t calls[STAGES];
+    uint64_t ticks[STAGES];
+    uint64_t bytes[STAGES];
+    uint64_t allocations;
+    uint64_t stack_high_water;
+
+    ~Counters() {
+        static const char* names[STAGES] = {
+            "read", "get_tag_all", "load", "parse", "decode", "count"
+        };
+        std::fprintf(stderr, "{\"stages\": {");
+        for (int s = 0; s < STAGES; s++) {
+            std::fprintf(stderr, "%s\"%s\": {\"calls\": %llu, \"ticks\": %llu, \"bytes\": %llu}",
+                         s > 0 ? ", " : "", names[s], (unsigned long long) calls[s],
+                         (unsigned long long) ticks[s], (unsigned long long) bytes[s]);
+        }
+        std::fprintf(stderr, "}, \"allocations\": %llu, \"sweep_stack_high_water\": %llu}\n",
+                     (unsigned long long) allocations, (unsigned long long) stack_high_water);
+    }
+};
+
+// Zero initialized before any dynamic initialization, so allocations made
+// by other static constructors are counted too.
+static Counters counters;
+
+class Scope {
+ public:
+    explicit Scope(Stage stage):
+        stage_{stage},
+        start_{ticks()}
+    {}
+
+    ~Scope() {
+        counters.calls[stage_]++;
+        counters.ticks[stage_] += ticks() - start_;
+    }
+
+ private:
+    Stage stage_;
+    uint64_t start_;
+};
+
+inline void add_bytes(Stage stage, uint64_t bytes) {
+    counters.bytes[stage] += bytes;
+}
+
+inline void stack_depth(uint64_t depth) {
+    if (depth > counters.stack_high_water) {
+        counters.stack_high_water = depth;
+    }
+}
+
+}  // namespace profile
+
+// Counting replacements of the global allocation functions. They can only
+// be defined once per program, which holds for every binary here since
+// each is built from a single translation unit.
+void* operator new(std::size_t size) {
+    profile::counters.allocations++;
+    void* p = std::malloc(size ? size : 1);
+    if (p == nullptr) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+#define PROFILE_CAT_(a, b) a##b
+#define PROFILE_CAT(a, b) PROFILE_CAT_(a, b)
+#define PROFILE_SCOPE(stage) profile::Scope PROFILE_CAT(profile_scope_, __LINE__)(profile::stage)
+#define PROFILE_BYTES(stage, n) profile::add_bytes(profile::stage, n)
+#define PROFILE_STACK_DEPTH(n) profile::stack_depth(n)
+
+#else
+
+// The arguments are never evaluated; sizeof only keeps the variables
+// they name in use.
+#define PROFILE_SCOPE(stage)
+#define PROFILE_BYTES(stage, n) ((void)sizeof(n))
+#define PROFILE_STACK_DEPTH(n) ((void)sizeof(n))
+
+#endif
+
+#endif
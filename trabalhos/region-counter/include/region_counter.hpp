@@ -0,0 +1,237 @@
+#ifndef IMAGE_REGION_COUNTER_H
+#define IMAGE_REGION_COUNTER_H
+
+#include <vector>
+
+#include "array_stack.hpp"
+#include "bitmap.hpp"
+#include "profile.hpp"
+
+namespace image {
+
+class Point {
+ public:
+    Point() {}
+    Point(int x_, int y_) :
+        x{x_},
+        y{y_}
+    {}
+
+    int x{0};
+    int y{0};
+};
+
+// Per-region measurements, one entry per region in the order the regions
+// are found (top to bottom, left to right by first pixel). Perimeter is
+// the number of pixel edges between the region and the background or the
+// image border.
+struct RegionStats {
+    std::vector<int> area;
+    std::vector<int> min_row;
+    std::vector<int> min_column;
+    std::vector<int> max_row;
+    std::vector<int> max_column;
+    std::vector<int> perimeter;
+    std::vector<double> row_sum;
+    std::vector<double> column_sum;
+
+    std::size_t size() const {
+        return area.size();
+    }
+
+    double centroid_row(std::size_t k) const {
+        return row_sum[k] / area[k];
+    }
+
+    double centroid_column(std::size_t k) const {
+        return column_sum[k] / area[k];
+    }
+
+    void clear() {
+        area.clear();
+        min_row.clear();
+        min_column.clear();
+        max_row.clear();
+        max_column.clear();
+        perimeter.clear();
+        row_sum.clear();
+        column_sum.clear();
+    }
+
+    void open(int i, int j) {
+        area.push_back(0);
+        min_row.push_back(i);
+        min_column.push_back(j);
+        max_row.push_back(i);
+        max_column.push_back(j);
+        perimeter.push_back(0);
+        row_sum.push_back(0);
+        column_sum.push_back(0);
+    }
+};
+
+enum Connectivity {
+    FOUR = 4,   // (x-1, y), (x+1, y), (x, y-1), (x, y+1)
+    EIGHT = 8   // the four above plus the diagonals
+};
+
+// Euler number (regions minus holes) of a bitmap by bit-quad counting
+// (Gray, 1971), 64 windows of 2x2 pixels per step. Holes are background
+// regions under the complementary connectivity: 8 for FOUR, 4 for EIGHT.
+template<Connectivity C>
+int euler_number(const Bitmap &matrix) {
+    std::size_t words = matrix.words_per_row();
+    // Window j covers columns j - 1 and j, for j in [0, columns].
+    std::size_t windows = (std::size_t(matrix.columns()) + 64) / 64;
+    std::size_t last_bits = (std::size_t(matrix.columns()) + 1) % 64;
+    uint64_t last_mask = last_bits == 0 ? ~uint64_t(0) : (uint64_t(1) << last_bits) - 1;
+    long q1 = 0;
+    long q3 = 0;
+    long qd = 0;
+
+    for (int i = 0; i <= matrix.rows(); i++) {
+        const uint64_t* above = i > 0 ? matrix.row(i - 1) : nullptr;
+        const uint64_t* below = i < matrix.rows() ? matrix.row(i) : nullptr;
+        uint64_t carry_a = 0;
+        uint64_t carry_b = 0;
+        for (std::size_t w = 0; w < windows; w++) {
+            uint64_t a = above != nullptr && w < words ? above[w] : 0;
+            uint64_t b = below != nullptr && w < words ? below[w] : 0;
+            uint64_t a_left = a << 1 | carry_a;
+            uint64_t b_left = b << 1 | carry_b;
+            carry_a = a >> 63;
+            carry_b = b >> 63;
+
+            uint64_t mask = w == windows - 1 ? last_mask : ~uint64_t(0);
+            uint64_t odd = (a ^ a_left ^ b ^ b_left) & mask;
+            uint64_t pairs = (a & a_left) | (a & b) | (a & b_left)
+                           | (a_left & b) | (a_left & b_left) | (b & b_left);
+            uint64_t diagonal = ((a_left & b & ~a & ~b_left) | (a & b_left & ~a_left & ~b)) & mask;
+            q1 += __builtin_popcountll(odd & ~pairs);
+            q3 += __builtin_popcountll(odd & pairs);
+            qd += __builtin_popcountll(diagonal);
+        }
+    }
+    return C == FOUR ? int((q1 - q3 + 2 * qd) / 4) : int((q1 - q3 - 2 * qd) / 4);
+}
+
+// Counts regions of set pixels under the given connectivity, which is a
+// template parameter so each variant gets its own sweep loop. The bitmap
+// is consumed: every region is cleared as it is swept. The sweep stack
+// is reused between calls. With stats the sweep also fills them, at the
+// cost of one copy of the bitmap.
+template<Connectivity C>
+class RegionCounter {
+ public:
+    // When holes is given it receives the number of holes as well, from
+    // the Euler number of the bitmap taken before the sweep consumes it.
+    int count(Bitmap &matrix, RegionStats* stats = nullptr, int* holes = nullptr) {
+        PROFILE_SCOPE(COUNT);
+        PROFILE_BYTES(COUNT, matrix.words_per_row() * matrix.rows() * sizeof(uint64_t));
+        int euler = holes != nullptr ? euler_number<C>(matrix) : 0;
+        int regions;
+        if (stats != nullptr) {
+            stats->clear();
+            original_.assign(matrix);
+            regions = count<true>(matrix, stats);
+        } else {
+            regions = count<false>(matrix, stats);
+        }
+        if (holes != nullptr) {
+            *holes = regions - euler;
+        }
+        return regions;
+    }
+
+ private:
+    template<bool Stats>
+    int count(Bitmap &matrix, RegionStats* stats) {
+        int regions = 0;
+        int columns = matrix.columns();
+        for (int i = 0; i < matrix.rows(); i++) {
+            int j = matrix.next_set(i, 0, columns);
+            while (j < columns) {
+                if (Stats) {
+                    stats->open(i, j);
+                }
+                sweep<Stats>(matrix, Point(i, j), stats);
+                regions++;
+                j = matrix.next_set(i, j, columns);
+            }
+        }
+        return regions;
+    }
+
+    // Scanline fill: each popped seed clears the whole horizontal run it
+    // belongs to, then pushes one seed per run touching it in the rows
+    // above and below.
+    template<bool Stats>
+    void sweep(Bitmap &matrix, Point first_p, RegionStats* stats) {
+        int rows = matrix.rows();
+
+        points_.clear();
+        points_.push(first_p);
+
+        while (!points_.empty()) {
+            Point p = points_.pop();
+            int i = p.x;
+
+            if (!matrix.get(i, p.y)) {
+                continue;
+            }
+            int begin = matrix.run_begin(i, p.y);
+            int end = matrix.run_end(i, p.y);
+            matrix.clear_span(i, begin, end);
+            if (Stats) {
+                measure(stats, i, begin, end);
+            }
+
+            // Diagonal neighbours widen the seeding range by one pixel
+            // on each side of the run.
+            int from = C == EIGHT && begin > 0 ? begin - 1 : begin;
+            int to = C == EIGHT && end < matrix.columns() ? end + 1 : end;
+            if (i > 0) {
+                seed(matrix, i - 1, from, to);
+            }
+            if (i < rows - 1) {
+                seed(matrix, i + 1, from, to);
+            }
+            PROFILE_STACK_DEPTH(points_.size());
+        }
+    }
+
+    void seed(const Bitmap &matrix, int i, int begin, int end) {
+        int j = matrix.next_set(i, begin, end);
+        while (j < end) {
+            points_.push(Point(i, j));
+            j = matrix.next_set(i, matrix.run_end(i, j), end);
+        }
+    }
+
+    // Adds the run [begin, end) of row i to the last region of stats. Runs
+    // are maximal, so they always have two vertical edges; horizontal edges
+    // are the pixels above and below that are background in the original.
+    void measure(RegionStats* stats, int i, int begin, int end) {
+        std::size_t k = stats->size() - 1;
+        int length = end - begin;
+
+        stats->area[k] += length;
+        stats->row_sum[k] += double(i) * length;
+        stats->column_sum[k] += (double(begin) + end - 1) * length / 2;
+        if (begin < stats->min_column[k]) stats->min_column[k] = begin;
+        if (end - 1 > stats->max_column[k]) stats->max_column[k] = end - 1;
+        if (i > stats->max_row[k]) stats->max_row[k] = i;
+
+        int perimeter = 2;
+        perimeter += length - (i > 0 ? original_.count(i - 1, begin, end) : 0);
+        perimeter += length - (i < original_.rows() - 1 ? original_.count(i + 1, begin, end) : 0);
+        stats->perimeter[k] += perimeter;
+    }
+
+    structures::ArrayStack<Point> points_;
+    Bitmap original_;
+};
+
+}  // namespace image
+
+#endif
@@ -0,0 +1,145 @@
+#ifndef IMAGE_RESULT_CACHE_H
+#define IMAGE_RESULT_CACHE_H
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+
+namespace image {
+
+// Fast non-cryptographic 64 bit hash, eight bytes per step.
+inline uint64_t hash_bytes(const char* data, std::size_t size, uint64_t seed = 0) {
+    const uint64_t k1 = 0x9e3779b97f4a7c15ull;
+    const uint64_t k2 = 0xbf58476d1ce4e5b9ull;
+    uint64_t h = seed ^ (size * k1);
+    std::size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        uint64_t word;
+        std::memcpy(&word, data + i, 8);
+        h ^= word * k2;
+        h = ((h << 31) | (h >> 33)) * k1;
+    }
+    uint64_t tail = 0;
+    std::memcpy(&tail, data + i, size - i);
+    h ^= tail * k2;
+    h ^= h >> 30;
+    h *= k2;
+    h ^= h >> 27;
+    h *= 0x94d049bb133111ebull;
+    return h ^ (h >> 31);
+}
+
+// Persistent map of (dataset path, image name) to (hash of its data,
+// region count), so a run can skip images that have not changed since the
+// previous one. The file is a magic string followed by (key length, key,
+// hash, count) entries; an unreadable file is treated as an empty cache
+// and a corrupt one is read up to the first bad entry.
+class ResultCache {
+ public:
+    explicit ResultCache(const std::string &path):
+        path_{path}
+    {
+        std::ifstream file(path_.c_str(), std::ios::binary);
+        char magic[sizeof(MAGIC)];
+        if (!file.read(magic, sizeof(magic)) || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0) {
+            return;
+        }
+        std::string key;
+        uint32_t size;
+        Entry entry;
+        while (file.read(reinterpret_cast<char*>(&size), sizeof(size)) && size <= MAX_KEY) {
+            key.resize(size);
+            if (!file.read(&key[0], size)
+                || !file.read(reinterpret_cast<char*>(&entry), sizeof(entry))) {
+                break;
+            }
+            entries_[key] = entry;
+        }
+    }
+
+    ~ResultCache() {
+        save();
+    }
+
+    bool find(const std::string &dataset, const std::string &name, uint64_t hash, long &count) {
+        std::unordered_map<std::string, Entry>::const_iterator it = entries_.find(key(dataset, name));
+        if (it == entries_.end() || it->second.hash != hash) {
+            misses_++;
+            return false;
+        }
+        count = it->second.count;
+        hits_++;
+        return true;
+    }
+
+    void store(const std::string &dataset, const std::string &name, uint64_t hash, long count) {
+        Entry entry = {hash, count};
+        entries_[key(dataset, name)] = entry;
+        dirty_ = true;
+    }
+
+    // Writes to a temporary file first so an interrupted run never leaves
+    // a truncated cache behind.
+    void save() {
+        if (!dirty_) {
+            return;
+        }
+        std::string temporary = path_ + ".tmp";
+        {
+            std::ofstream file(temporary.c_str(), std::ios::binary | std::ios::trunc);
+            file.write(MAGIC, sizeof(MAGIC));
+            std::unordered_map<std::string, Entry>::const_iterator it;
+            for (it = entries_.begin(); it != entries_.end(); ++it) {
+                uint32_t size = it->first.size();
+                file.write(reinterpret_cast<const char*>(&size), sizeof(size));
+                file.write(it->first.data(), size);
+                file.write(reinterpret_cast<const char*>(&it->second), sizeof(it->second));
+            }
+            if (!file) {
+                return;
+            }
+        }
+        std::rename(temporary.c_str(), path_.c_str());
+        dirty_ = false;
+    }
+
+    long hits() const {
+        return hits_;
+    }
+
+    long misses() const {
+        return misses_;
+    }
+
+ private:
+    struct Entry {
+        uint64_t hash;
+        int64_t count;
+    };
+
+    // Image names repeat across datasets, so the path is part of the key.
+    static std::string key(const std::string &dataset, const std::string &name) {
+        std::string key(dataset);
+        key += '\0';
+        key += name;
+        return key;
+    }
+
+    static const char MAGIC[8];
+    static const uint32_t MAX_KEY = 1 << 16;
+
+    std::string path_;
+    std::unordered_map<std::string, Entry> entries_;
+    long hits_{0};
+    long misses_{0};
+    bool dirty_{false};
+};
+
+const char ResultCache::MAGIC[8] = {'R', 'C', 'C', 'A', 'C', 'H', 'E', '2'};
+
+}  // namespace image
+
+#endif
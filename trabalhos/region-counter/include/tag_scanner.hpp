@@ -0,0 +1,121 @@
+#ifndef XML_TAG_SCANNER_H
+#define XML_TAG_SCANNER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace XML {
+
+// Bit i of the result is set when p[i] == c, for the n < 64 bytes at p.
+inline uint64_t match_tail(const char* p, std::size_t n, char c) {
+    uint64_t mask = 0;
+    for (std::size_t i = 0; i < n; i++) {
+        mask |= uint64_t(p[i] == c) << i;
+    }
+    return mask;
+}
+
+// Bit i of the result is set when p[i] == c, for the 64 bytes at p.
+inline uint64_t match_block(const char* p, char c) {
+#if defined(__AVX2__)
+    const __m256i needle = _mm256_set1_epi8(c);
+    __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 32));
+    return uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, needle)))
+        | uint64_t(uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, needle)))) << 32;
+#elif defined(__SSE2__)
+    const __m128i needle = _mm_set1_epi8(c);
+    uint64_t mask = 0;
+    for (int i = 0; i < 4; i++) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16 * i));
+        mask |= uint64_t(uint16_t(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, needle)))) << (16 * i);
+    }
+    return mask;
+#else
+    return match_tail(p, 64, c);
+#endif
+}
+
+// Walks the tags of a buffer using the block masks above instead of
+// searching for each character with std::string::find.
+class TagScanner {
+ public:
+    struct Tag {
+        std::size_t begin;  // position of '<'
+        std::size_t end;    // position of '>'
+        bool closing;
+    };
+
+    static const std::size_t npos = std::size_t(-1);
+
+    TagScanner(const char* data, std::size_t size, std::size_t start = 0):
+        data_{data},
+        size_{size},
+        pos_{start}
+    {}
+
+    bool next(Tag& tag) {
+        std::size_t opener = find(OPEN, pos_);
+        if (opener == npos) {
+            pos_ = size_;
+            return false;
+        }
+        std::size_t closer = find(CLOSE, opener + 1);
+        if (closer == npos) {
+            throw std::out_of_range("Bad XML format");
+        }
+        tag.begin = opener;
+        tag.end = closer;
+        // closer > opener, so opener + 1 is inside the buffer.
+        tag.closing = data_[opener + 1] == '/';
+        pos_ = closer + 1;
+        return true;
+    }
+
+    std::size_t position() const {
+        return pos_;
+    }
+
+ private:
+    enum Kind { OPEN, CLOSE };
+
+    // Each character class keeps the mask of the last block it looked at,
+    // so consecutive searches inside one block share a single comparison.
+    std::size_t find(Kind kind, std::size_t from) {
+        static const char needles[] = {'<', '>'};
+        while (from < size_) {
+            std::size_t base = from & ~std::size_t(63);
+            if (base != base_[kind]) {
+                if (base + 64 <= size_) {
+                    masks_[kind] = match_block(data_ + base, needles[kind]);
+                } else {
+                    masks_[kind] = match_tail(data_ + base, size_ - base, needles[kind]);
+                }
+                base_[kind] = base;
+            }
+            uint64_t mask = masks_[kind] >> (from - base);
+            if (mask != 0) {
+                return from + __builtin_ctzll(mask);
+            }
+            from = base + 64;
+        }
+        return npos;
+    }
+
+    const char* data_;
+    std::size_t size_;
+    std::size_t pos_;
+    std::size_t base_[2] = {npos, npos};
+    uint64_t masks_[2] = {0, 0};
+};
+
+}  // namespace XML
+
+#endif
@@ -1,70 +1,153 @@
 #ifndef XML_TOOLS_H
 #define XML_TOOLS_H
 
+#include <algorithm>
+#include <fstream>
 #include <string>
 
+#include "linked_stack.hpp"
 #include "linked_queue.hpp"
+#include "tag_scanner.hpp"
+#include "profile.hpp"
 
 using namespace std;
 
 namespace XML {
 
-string read(const char* path) {
-    string output;
+void validate(const string &xml_string) {
     structures::LinkedStack<string> tag_stack;
-    ifstream file(path);
-
-    if (file.is_open()) {
-        string line;
-        while (getline(file, line)) {
-            int opener = line.find('<');
-            while (opener != -1) {
-                int closer = line.find('>', opener);
-                if (line[opener + 1] == '/') {
-                    string last_tag = tag_stack.pop();
-                    if (line.substr(opener + 2, last_tag.size()) != last_tag) {
-                        throw out_of_range("Bad XML format");
-                    }
-                } else {
-                    string tag = line.substr(opener + 1, closer - opener - 1);
-                    tag_stack.push(tag);
-                }
-                opener = line.find('<', closer);
+    TagScanner scanner(xml_string.data(), xml_string.size());
+    TagScanner::Tag tag;
+
+    while (scanner.next(tag)) {
+        if (tag.closing) {
+            if (tag_stack.empty()) {
+                throw out_of_range("Bad XML format");
             }
-            output += line + ' ';
+            string last_tag = tag_stack.pop();
+            if (xml_string.compare(tag.begin + 2, tag.end - tag.begin - 2, last_tag) != 0) {
+                throw out_of_range("Bad XML format");
+            }
+        } else {
+            tag_stack.push(xml_string.substr(tag.begin + 1, tag.end - tag.begin - 1));
         }
-        file.close();
-    } else {
-        throw out_of_range("Unable to open file");
     }
     if (tag_stack.size() != 0) {
         throw out_of_range("Bad XML format");
     }
+}
+
+// Newlines become spaces and the text always ends with a space, the
+// layout the line by line reader used to produce.
+void finish_read(string &output) {
+    replace(output.begin(), output.end(), '\n', ' ');
+    if (!output.empty() && output[output.size() - 1] != ' ') {
+        output += ' ';
+    }
+    validate(output);
+}
+
+void append_chunks(istream &input, string &output) {
+    char buffer[1 << 16];
+    while (input.read(buffer, sizeof(buffer)) || input.gcount() > 0) {
+        output.append(buffer, input.gcount());
+    }
+}
+
+// Reads a whole stream into output as is, reusing its storage.
+void load(istream &input, string &output) {
+    PROFILE_SCOPE(LOAD);
+    output.clear();
+    append_chunks(input, output);
+    PROFILE_BYTES(LOAD, output.size());
+}
+
+// Reads a whole file into output as is, reusing its storage. Pipes and
+// other inputs that cannot seek are read in chunks.
+void load(const char* path, string &output) {
+    PROFILE_SCOPE(LOAD);
+    ifstream file(path, ios::binary);
+    if (!file.is_open()) {
+        throw out_of_range("Unable to open file");
+    }
+    file.seekg(0, ios::end);
+    streamoff size = file.tellg();
+    output.clear();
+    if (size < 0) {
+        file.clear();
+        append_chunks(file, output);
+    } else {
+        output.resize(size);
+        file.seekg(0, ios::beg);
+        file.read(&output[0], output.size());
+    }
+    file.close();
+    PROFILE_BYTES(LOAD, output.size());
+}
+
+// Reads and validates a whole stream into output, reusing its storage.
+void read(istream &input, string &output) {
+    PROFILE_SCOPE(READ);
+    load(input, output);
+    PROFILE_BYTES(READ, output.size());
+    finish_read(output);
+}
+
+// Reads and validates a file into output, reusing its storage.
+void read(const char* path, string &output) {
+    PROFILE_SCOPE(READ);
+    load(path, output);
+    PROFILE_BYTES(READ, output.size());
+    finish_read(output);
+}
+
+string read(const char* path) {
+    string output;
+    read(path, output);
     return output;
 }
 
+// Finds the first <tag>...</tag> at or after start. On success the content
+// is [begin, end) and next is the position right after the closing tag.
+// The whole tag strings are searched with std::string::find, which skips
+// over the other tags faster than walking them with the scanner.
+bool find_tag(const string &xml_string, const string &tag, size_t start,
+              size_t &begin, size_t &end, size_t &next) {
+    size_t opener = xml_string.find('<' + tag + '>', start);
+    if (opener == string::npos) {
+        return false;
+    }
+    begin = opener + tag.size() + 2;
+    size_t closer = xml_string.find("</" + tag + '>', begin);
+    if (closer == string::npos) {
+        return false;
+    }
+    end = closer;
+    next = closer + tag.size() + 3;
+    return true;
+}
+
 string get_tag(const string &xml_string, string tag, int start) {
-    int opener = xml_string.find('<' + tag + '>', start);
-    int closer = xml_string.find("</" + tag + '>', opener);
-    int opener_end = opener + tag.size() + 2;
-    return xml_string.substr(opener_end, closer - opener_end);
+    size_t begin, end, next;
+    if (!find_tag(xml_string, tag, start, begin, end, next)) {
+        throw out_of_range("Tag not found");
+    }
+    return xml_string.substr(begin, end - begin);
 }
 
 structures::LinkedQueue<string> get_tag_all(const string &xml_string, string tag) {
+    PROFILE_SCOPE(GET_TAG_ALL);
+    PROFILE_BYTES(GET_TAG_ALL, xml_string.size());
     structures::LinkedQueue<string> output;
-    
-    string last;
-    int start = 0;
-    bool remain = true;
-    while (remain) {
-        last = get_tag(xml_string, tag, start);
-        output.enqueue(last);
-        start += last.size();
-        remain = (int)xml_string.find('<' + tag + '>', start) != -1;
+
+    size_t begin, end;
+    size_t start = 0;
+    while (find_tag(xml_string, tag, start, begin, end, start)) {
+        output.enqueue(xml_string.substr(begin, end - begin));
     }
     return output;
 }
 
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -1,127 +1,307 @@
 #include <iostream>
 #include <fstream>
+#include <memory>
 #include <string>
-#include <vector>
+#include <cstdio>
 #include <stdexcept>
 #include <unistd.h>
 
+#include "./include/bitmap.hpp"
+#include "./include/image_loader.hpp"
 #include "./include/linked_stack.hpp"
 #include "./include/linked_queue.hpp"
+#include "./include/region_counter.hpp"
+#include "./include/result_cache.hpp"
 #include "./include/xml_tools.hpp"
+#include "./include/mapped_file.hpp"
+#include "./include/packed_dataset.hpp"
 
 using namespace std;
 
 
-class Point {
+// Collects everything written to stdout and hands it over in large
+// blocks, so batches of many datasets go through a single buffer.
+class Output {
  public:
-    Point(int x_, int y_) :
-        x{x_},
-        y{y_}
-    {}
-    ~Point() {}
+    Output() {
+        buffer_.reserve(CAPACITY);
+    }
 
-    int x;
-    int y;
+    ~Output() {
+        flush();
+    }
 
-};
+    Output& operator<<(const string &text) {
+        buffer_ += text;
+        return check();
+    }
+
+    Output& operator<<(char c) {
+        buffer_ += c;
+        return check();
+    }
 
+    Output& operator<<(long value) {
+        char text[24];
+        buffer_.append(text, snprintf(text, sizeof(text), "%ld", value));
+        return check();
+    }
 
-void sweep(int** matrix, int rows, int columns, Point first_p) {
-    structures::LinkedStack<Point> points;
+    Output& operator<<(double value) {
+        char text[32];
+        buffer_.append(text, snprintf(text, sizeof(text), "%g", value));
+        return check();
+    }
 
-    points.push(first_p);
+    // Output written between hold() and release() is kept in memory, so it
+    // can still be dropped with discard() if the dataset turns out bad.
+    void hold() {
+        held_ = buffer_.size();
+        holding_ = true;
+    }
 
-    while(!points.empty()) {
-        Point p = points.pop();
+    void release() {
+        holding_ = false;
+        check();
+    }
 
-        int i = p.x;
-        int j = p.y;
+    void discard() {
+        buffer_.resize(held_);
+        holding_ = false;
+    }
 
-        matrix[i][j] = 0;
+    void flush() {
+        fwrite(buffer_.data(), 1, buffer_.size(), stdout);
+        fflush(stdout);
+        buffer_.clear();
+    }
 
-        if (j > 0 && matrix[i][j - 1] == 1) {
-            points.push(Point(i, j - 1));
+ private:
+    Output& check() {
+        if (!holding_ && buffer_.size() >= CAPACITY) {
+            flush();
         }
-        if (j < columns - 1 && matrix[i][j + 1] == 1) {
-            points.push(Point(i, j + 1));
+        return *this;
+    }
+
+    string buffer_;
+    size_t held_{0u};
+    bool holding_{false};
+
+    static const size_t CAPACITY = 1 << 16;
+};
+
+
+struct Options {
+    bool with_stats{false};
+    bool with_holes{false};
+    int connectivity{4};
+    const char* cache_path{nullptr};
+};
+
+
+// Counts the regions of every image of a dataset, given either as XML
+// text or in the packed binary format. The image buffers, the sweep stack
+// and the statistics are kept from one dataset to the next. With a cache,
+// images whose pixels hash the same as in an earlier run reuse the stored
+// count; --stats and --holes always count.
+template<image::Connectivity C>
+class DatasetCounter {
+ public:
+    DatasetCounter(Output &out, const Options &options, image::ResultCache* cache):
+        out_(out),
+        with_stats_{options.with_stats},
+        with_holes_{options.with_holes},
+        cache_{options.with_stats || options.with_holes ? nullptr : cache}
+    {}
+
+    // Nothing is written unless the whole dataset is well formed.
+    void count(const string &path, const char* data, size_t size) {
+        dataset_ = path;
+        out_.hold();
+        try {
+            if (image::PackedDataset::is_packed(data, size)) {
+                count_packed(image::PackedDataset(data, size));
+            } else {
+                count_xml(data, size);
+            }
+        } catch (...) {
+            out_.discard();
+            throw;
         }
-        if (i > 0 && matrix[i - 1][j] == 1) {
-            points.push(Point(i - 1, j));
+        out_.release();
+    }
+
+ private:
+    void count_xml(const char* xml, size_t size) {
+        XML::DatasetReader reader(xml, size);
+        XML::ImageRecord record;
+        while (reader.next(record)) {
+            name_.assign(xml + record.name_begin, record.name_end - record.name_begin);
+            const char* pixels = xml + record.data_begin;
+            size_t bytes = record.data_end - record.data_begin;
+            long a;
+            if (!cached(pixels, bytes, a)) {
+                report(loader_.load(xml, record));
+            }
         }
-        if (i < rows - 1 && matrix[i + 1][j] == 1) {
-            points.push(Point(i + 1, j));
+    }
+
+    void count_packed(const image::PackedDataset &dataset) {
+        for (size_t i = 0; i < dataset.size(); i++) {
+            dataset.name(i, name_);
+            size_t bytes;
+            const char* pixels = dataset.pixels(i, bytes);
+            long a;
+            if (!cached(pixels, bytes, a)) {
+                report(loader_.load(dataset, i));
+            }
         }
     }
-}
 
+    bool cached(const char* pixels, size_t bytes, long &a) {
+        if (cache_ == nullptr) {
+            return false;
+        }
+        hash_ = image::hash_bytes(pixels, bytes, C);
+        if (!cache_->find(dataset_, name_, hash_, a)) {
+            return false;
+        }
+        out_ << name_ << ' ' << a << '\n';
+        return true;
+    }
 
-structures::LinkedQueue<string> split(const string &string_, string separator) {
-    structures::LinkedQueue<string> output;
-    int last_sprt = string_.find(separator);
-    while (last_sprt != -1) {
-        int next_sprt = string_.find(separator, last_sprt + 1);
-        string s = string_.substr(last_sprt + 1, next_sprt - last_sprt -1);
-        if (s.size() == 0) break;
-        output.enqueue(s);
-        last_sprt = next_sprt;
+    void report(image::Bitmap &matrix) {
+        int holes;
+        long a = counter_.count(matrix, with_stats_ ? &stats_ : nullptr,
+                                with_holes_ ? &holes : nullptr);
+        if (cache_ != nullptr) {
+            cache_->store(dataset_, name_, hash_, a);
+        }
+        out_ << name_ << ' ' << a;
+        if (with_holes_) {
+            out_ << ' ' << long(holes);
+        }
+        out_ << '\n';
+        for (size_t k = 0; with_stats_ && k < stats_.size(); k++) {
+            out_ << '\t' << long(k + 1) << ' ' << long(stats_.area[k])
+                 << ' ' << long(stats_.min_row[k]) << ' ' << long(stats_.min_column[k])
+                 << ' ' << long(stats_.max_row[k]) << ' ' << long(stats_.max_column[k])
+                 << ' ' << stats_.centroid_row(k) << ' ' << stats_.centroid_column(k)
+                 << ' ' << long(stats_.perimeter[k]) << '\n';
+        }
     }
-    return output;
-}
 
-int** create_matrix(const structures::LinkedQueue<string> &matrix_str) {
-    int rows = matrix_str.size();
-    int columns = matrix_str[0].size();
+    Output &out_;
+    bool with_stats_;
+    bool with_holes_;
+    image::Loader loader_;
+    image::RegionCounter<C> counter_;
+    image::RegionStats stats_;
+    image::ResultCache* cache_;
+    string dataset_;
+    string name_;
+    uint64_t hash_{0};
+};
 
-    int** output = new int*[rows];
 
-    for (int i = 0; i < rows; i++) {
-        output[i] = new int[columns];
-        string line = matrix_str[i];
-        for (int j = 0; j < columns; j++) {
-            output[i][j] = (line[j] == '1');
+// Dataset paths come from the command line or, when there are none, one
+// per line from stdin. "-" reads the dataset itself from stdin.
+bool next_path(char** paths, int count, int &next, string &path) {
+    if (count > 0) {
+        if (next >= count) {
+            return false;
         }
+        path = paths[next++];
+        return true;
     }
-    return output;
+    while (getline(cin, path)) {
+        if (!path.empty()) {
+            return true;
+        }
+    }
+    return false;
 }
 
-int count_regions(const string &data) {
-    structures::LinkedQueue<string> d = split(data, " ");
-
-    int rows = d.size();
-    size_t columns = d[0].size(); // must be size_t because string uses it
-	
-    int** matrix_int = create_matrix(d);
+template<image::Connectivity C>
+int count_all(char** paths, int count, const Options &options) {
+    Output out;
+    unique_ptr<image::ResultCache> cache;
+    if (options.cache_path != nullptr) {
+        cache.reset(new image::ResultCache(options.cache_path));
+    }
+    DatasetCounter<C> dataset(out, options, cache.get());
+    string input;
+    string path;
+    int next = 0;
+    int status = 0;
 
-    int regions = 0;
-    for (int i = 0; i < rows; i++) {
-        for (size_t j = 0; j < columns; j++) {
-            if (matrix_int[i][j] == 1) {
-                sweep(matrix_int, rows, columns, Point(i, j));
-                regions++;
+    while (next_path(paths, count, next, path)) {
+        try {
+            if (path == "-" && count == 0) {
+                throw out_of_range("stdin already carries the dataset paths");
+            } else if (path == "-") {
+                XML::load(cin, input);
+                dataset.count(path, input.data(), input.size());
+            } else if (io::is_regular(path.c_str())) {
+                io::MappedFile file(path.c_str());
+                dataset.count(path, file.data(), file.size());
+            } else {
+                XML::load(path.c_str(), input);
+                dataset.count(path, input.data(), input.size());
             }
+        } catch (exception &e) {
+            out.flush();
+            cerr << path << ": " << e.what() << "\n";
+            status = 1;
         }
     }
-    for (int i = 0; i < rows; i++) {
-        delete matrix_int[i];
+    if (cache != nullptr) {
+        cache->save();
+        out.flush();
+        cerr << "cache: " << cache->hits() << " hits, " << cache->misses() << " misses\n";
     }
-    delete[] matrix_int;
-
-    return regions;
+    return status;
 }
 
 
-int main() {
-
-    // char xmlfilename[100];
-    string xml = XML::read("./datasets/dataset01.xml");
-    structures::LinkedQueue<string> images = XML::get_tag_all(xml, "img");
-
-	for (int i = 0; i < images.size(); i++) {
-		string name = XML::get_tag(images[i], "name", 0);
-		string data = XML::get_tag(images[i], "data", 0);
-		int a = count_regions(data);
-        cout << name << ' ' << a << "\n";
-	}
+// Usage: a.out [--stats] [--holes] [--connectivity 4|8] [--cache file]
+//              [dataset.xml ...]
+// Every image gets a "name regions" line, "name regions holes" with
+// --holes. With --stats it is followed by
+// one line per region: index area min_row min_column max_row max_column
+// centroid_row centroid_column perimeter.
+int main(int argc, char* argv[]) {
+    Options options;
+    int i = 1;
+    for (; i < argc && argv[i][0] == '-' && argv[i][1] == '-'; i++) {
+        string arg = argv[i];
+        if (arg == "--stats") {
+            options.with_stats = true;
+        } else if (arg == "--holes") {
+            options.with_holes = true;
+        } else if (arg == "--connectivity" && i + 1 < argc) {
+            options.connectivity = atoi(argv[++i]);
+        } else if (arg == "--cache" && i + 1 < argc) {
+            options.cache_path = argv[++i];
+        } else {
+            options.connectivity = 0;
+        }
+        if (options.connectivity != 4 && options.connectivity != 8) {
+            cerr << "usage: " << argv[0] << " [--stats] [--holes] [--connectivity 4|8]"
+                 << " [--cache file] [dataset.xml ...]\n";
+            return 1;
+        }
+    }
 
-    return 0;
-}
\ No newline at end of file
+    // Caught here so the stack unwinds and the cache is still saved.
+    try {
+        if (options.connectivity == 8) {
+            return count_all<image::EIGHT>(argv + i, argc - i, options);
+        }
+        return count_all<image::FOUR>(argv + i, argc - i, options);
+    } catch (exception &e) {
+        cerr << e.what() << "\n";
+        return 1;
+    }
+}
@@ -0,0 +1,66 @@
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "../include/dataset_reader.hpp"
+#include "../include/image_loader.hpp"
+#include "../include/mapped_file.hpp"
+#include "../include/packed_dataset.hpp"
+#include "../include/xml_tools.hpp"
+
+using namespace std;
+
+void pack(const char* xml, size_t size, image::Loader &loader, image::PackedWriter &writer) {
+    XML::DatasetReader reader(xml, size);
+    XML::ImageRecord record;
+    while (reader.next(record)) {
+        image::Bitmap &matrix = loader.load(xml, record);
+        writer.add(loader.name(), matrix);
+    }
+}
+
+// Usage: pack_dataset.out output.rcp dataset.xml ...
+// Converts XML datasets into a single packed dataset, validating them on
+// the way. The output is written to a temporary file and only renamed
+// into place once every dataset has been packed.
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        cerr << "usage: " << argv[0] << " output.rcp dataset.xml ...\n";
+        return 1;
+    }
+    string temporary = string(argv[1]) + ".tmp";
+    ofstream out(temporary.c_str(), ios::binary | ios::trunc);
+    if (!out.is_open()) {
+        cerr << argv[1] << ": Unable to open file\n";
+        return 1;
+    }
+    image::PackedWriter writer(out);
+    image::Loader loader;
+    string input;
+
+    for (int i = 2; i < argc; i++) {
+        try {
+            if (io::is_regular(argv[i])) {
+                io::MappedFile file(argv[i]);
+                pack(file.data(), file.size(), loader, writer);
+            } else {
+                XML::load(argv[i], input);
+                pack(input.data(), input.size(), loader, writer);
+            }
+        } catch (exception &e) {
+            cerr << argv[i] << ": " << e.what() << "\n";
+            out.close();
+            remove(temporary.c_str());
+            return 1;
+        }
+    }
+    writer.finish();
+    out.close();
+    if (out.fail() || rename(temporary.c_str(), argv[1]) != 0) {
+        cerr << argv[1] << ": Unable to write file\n";
+        remove(temporary.c_str());
+        return 1;
+    }
+    return 0;
+}